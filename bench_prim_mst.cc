@@ -0,0 +1,710 @@
+// @copyright 2019 Shivani Parekh and Urmi Lalchandani
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "boruvka_mst.h"
+#include "dynamic_mst.h"
+#include "ewd_reader.h"
+#include "forest_mst.h"
+#include "graph.h"
+#include "index_min_pq.h"
+#include "index_pairing_pq.h"
+#include "index_radix_pq.h"
+#include "kruskal_mst.h"
+#include "lazy_prim_mst.h"
+#include "mst.h"
+#include "perf_counters.h"
+#include "prim_key.h"
+#include "reorder.h"
+
+// Random connected graph with @num_vertices vertices and about @degree
+// edges per vertex: a random spanning path plus uniformly random edges.
+static Graph RandomGraph(unsigned int num_vertices, unsigned int degree) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<unsigned int> vertex(0, num_vertices - 1);
+  std::uniform_real_distribution<double> weight(0.0, 1.0);
+
+  std::vector<Edge> edges;
+  edges.reserve(static_cast<size_t>(num_vertices) * degree);
+  for (unsigned int v = 1; v < num_vertices; v++)
+    edges.push_back(Edge(v - 1, v, weight(gen)));
+  while (edges.size() < static_cast<size_t>(num_vertices) * degree)
+    edges.push_back(Edge(vertex(gen), vertex(gen), weight(gen)));
+  return Graph(num_vertices, std::move(edges));
+}
+
+// Prim's on sparse random graphs of growing size; the fitted complexity
+// must stay O(E log V) (reported as NlgN in E), for the default heap and
+// for the radix heap, whose bucket 0 takes most keys on such graphs
+template <typename PQ>
+static void BM_PrimSparse(benchmark::State &state) {
+  Graph graph = RandomGraph(state.range(0), 8);
+  for (auto _ : state) {
+    MST<PQ> mst(graph, PrimMode::kHeap);
+    benchmark::DoNotOptimize(mst.Edges().data());
+  }
+  state.SetComplexityN(graph.GetNumEdges());
+}
+BENCHMARK_TEMPLATE(BM_PrimSparse, IndexMinPQ<PrimKey>)
+  ->RangeMultiplier(4)->Range(1 << 10, 1 << 16)
+  ->Unit(benchmark::kMillisecond)
+  ->Complexity(benchmark::oNLogN);
+BENCHMARK_TEMPLATE(BM_PrimSparse, IndexRadixPQ<PrimKey>)
+  ->RangeMultiplier(4)->Range(1 << 10, 1 << 18)
+  ->Unit(benchmark::kMillisecond)
+  ->Complexity(benchmark::oNLogN);
+
+// Prim's on a dense random graph, where ChangeKey calls outnumber Pops,
+// for each heap layout
+template <typename PQ>
+static void BM_PrimHeap(benchmark::State &state) {
+  Graph graph = RandomGraph(state.range(0), 64);
+  for (auto _ : state) {
+    MST<PQ> mst(graph);
+    benchmark::DoNotOptimize(mst.Edges().data());
+  }
+}
+BENCHMARK_TEMPLATE(BM_PrimHeap, IndexMinPQ<PrimKey, 2>)
+  ->Arg(1 << 14)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PrimHeap, IndexMinPQ<PrimKey, 4>)
+  ->Arg(1 << 14)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PrimHeap, IndexMinPQ<PrimKey, 8>)
+  ->Arg(1 << 14)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PrimHeap, IndexMinPQ<PrimKey, 2, true>)
+  ->Arg(1 << 14)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PrimHeap, IndexMinPQ<PrimKey, 4, true>)
+  ->Arg(1 << 14)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PrimHeap, IndexMinPQ<PrimKey, 8, true>)
+  ->Arg(1 << 14)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PrimHeap, IndexPairingPQ<PrimKey>)
+  ->Arg(1 << 14)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PrimHeap, IndexRadixPQ<PrimKey>)
+  ->Arg(1 << 14)->Unit(benchmark::kMillisecond);
+
+// Key orders for the queue benchmarks: random; ascending, the easy case
+// where nothing sifts; or descending, the adversarial case where every
+// push and every key decrease sifts all the way to the root
+enum KeyOrder { kRandomKeys, kAscendingKeys, kDescendingKeys };
+
+// @n keys in @order
+static std::vector<double> Keys(size_t n, int order) {
+  std::vector<double> keys(n);
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> random(0.0, 1.0);
+  for (size_t i = 0; i < n; i++) {
+    if (order == kRandomKeys)
+      keys[i] = random(gen);
+    else
+      keys[i] = order == kAscendingKeys ? i : n - i;
+  }
+  return keys;
+}
+
+// Pushes state.range(0) keys in KeyOrder state.range(1), then pops them
+// all
+template <typename PQ>
+static void BM_PQPushPop(benchmark::State &state) {
+  const size_t n = state.range(0);
+  std::vector<double> keys = Keys(n, state.range(1));
+  for (auto _ : state) {
+    PQ pqueue(n);
+    for (unsigned int i = 0; i < n; i++)
+      pqueue.Push(keys[i], i);
+    while (pqueue.Size() > 0) {
+      benchmark::DoNotOptimize(pqueue.Top());
+      pqueue.Pop();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_PQPushPop, IndexMinPQ<double>)
+  ->ArgNames({"n", "order"})
+  ->ArgsProduct({benchmark::CreateRange(1000, 10000000, 10),
+                 {kRandomKeys, kAscendingKeys, kDescendingKeys}})
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PQPushPop, IndexMinPQ<double, 4>)
+  ->ArgNames({"n", "order"})
+  ->ArgsProduct({benchmark::CreateRange(1000, 10000000, 10),
+                 {kRandomKeys, kDescendingKeys}})
+  ->Unit(benchmark::kMillisecond);
+
+// Fills a queue with state.range(0) random keys, then lowers every key
+// once: to a random smaller value, or (KeyOrder kDescendingKeys) below
+// the current minimum, in random index order
+template <typename PQ>
+static void BM_PQChangeKey(benchmark::State &state) {
+  const size_t n = state.range(0);
+  std::vector<double> keys = Keys(n, kRandomKeys);
+  std::vector<unsigned int> order(n);
+  for (unsigned int i = 0; i < n; i++)
+    order[i] = i;
+  std::mt19937 gen(7);
+  std::shuffle(order.begin(), order.end(), gen);
+  bool adversarial = state.range(1) == kDescendingKeys;
+  for (auto _ : state) {
+    state.PauseTiming();
+    PQ pqueue(n);
+    for (unsigned int i = 0; i < n; i++)
+      pqueue.Push(keys[i], i);
+    state.ResumeTiming();
+    double lowest = 0;
+    for (unsigned int i : order)
+      pqueue.ChangeKey(adversarial ? --lowest : keys[i] / 2, i);
+    benchmark::DoNotOptimize(pqueue.Top());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_PQChangeKey, IndexMinPQ<double>)
+  ->ArgNames({"n", "order"})
+  ->ArgsProduct({benchmark::CreateRange(1000, 10000000, 10),
+                 {kRandomKeys, kDescendingKeys}})
+  ->Unit(benchmark::kMillisecond);
+
+// Loads state.range(0) keys in KeyOrder state.range(1) into an empty
+// queue: one Push each (range(2) = 0) or one PushBatch (1)
+static void BM_PQBuild(benchmark::State &state) {
+  const size_t n = state.range(0);
+  std::vector<double> keys = Keys(n, state.range(1));
+  std::vector<std::pair<double, unsigned int>> items;
+  for (unsigned int i = 0; i < n; i++)
+    items.emplace_back(keys[i], i);
+  for (auto _ : state) {
+    IndexMinPQ<double> pqueue(n);
+    if (state.range(2)) {
+      pqueue.PushBatch(items);
+    } else {
+      for (const auto &item : items)
+        pqueue.Push(item.first, item.second);
+    }
+    benchmark::DoNotOptimize(pqueue.Top());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_PQBuild)
+  ->ArgNames({"n", "order", "batch"})
+  ->ArgsProduct({benchmark::CreateRange(1000, 1000000, 10),
+                 {kRandomKeys, kDescendingKeys}, {0, 1}})
+  ->Unit(benchmark::kMillisecond);
+
+// Lowers every key of a queue of state.range(0) random keys, by one
+// ChangeKey each (range(1) = 0) or one ChangeKeyBatch (1)
+static void BM_PQChangeKeyBatch(benchmark::State &state) {
+  const size_t n = state.range(0);
+  std::vector<double> keys = Keys(n, kRandomKeys);
+  std::vector<std::pair<double, unsigned int>> items;
+  for (unsigned int i = 0; i < n; i++)
+    items.emplace_back(keys[i] / 2, i);
+  std::mt19937 gen(7);
+  std::shuffle(items.begin(), items.end(), gen);
+  for (auto _ : state) {
+    state.PauseTiming();
+    IndexMinPQ<double> pqueue(n);
+    for (unsigned int i = 0; i < n; i++)
+      pqueue.Push(keys[i], i);
+    state.ResumeTiming();
+    if (state.range(1)) {
+      pqueue.ChangeKeyBatch(items);
+    } else {
+      for (const auto &item : items)
+        pqueue.ChangeKey(item.first, item.second);
+    }
+    benchmark::DoNotOptimize(pqueue.Top());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_PQChangeKeyBatch)
+  ->ArgNames({"n", "batch"})
+  ->ArgsProduct({benchmark::CreateRange(1000, 1000000, 10), {0, 1}})
+  ->Unit(benchmark::kMillisecond);
+
+// Loads a bundled EWD file the way prim_mst does
+static Graph LoadEWDGraph(const char *path) {
+  MappedFile file(path);
+  EWDReader reader(file.Begin(), file.End());
+  std::vector<Edge> edges;
+  reader.ParseEdges(edges);
+  DedupEdges(edges);
+  return Graph(reader.NumVertices(), std::move(edges));
+}
+
+// Prim's on the sparse 10000EWD graph for each priority queue
+template <typename PQ>
+static void BM_PrimHeapEWD(benchmark::State &state) {
+  Graph graph = LoadEWDGraph("10000EWD.txt");
+  for (auto _ : state) {
+    MST<PQ> mst(graph);
+    benchmark::DoNotOptimize(mst.Edges().data());
+  }
+}
+BENCHMARK_TEMPLATE(BM_PrimHeapEWD, IndexMinPQ<PrimKey, 2>)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PrimHeapEWD, IndexMinPQ<PrimKey, 4>)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PrimHeapEWD, IndexMinPQ<PrimKey, 8>)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PrimHeapEWD, IndexPairingPQ<PrimKey>)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PrimHeapEWD, IndexRadixPQ<PrimKey>)
+  ->Unit(benchmark::kMillisecond);
+
+// Kruskal's against Prim's on every bundled EWD file, from the parsed edge
+// list as prim_mst --engine kruskal runs it
+static void BM_KruskalEWD(benchmark::State &state, const char *path) {
+  try {
+    Graph graph = LoadEWDGraph(path);
+    for (auto _ : state) {
+      KruskalMST mst(graph.NumVertices(), graph.Edges());
+      benchmark::DoNotOptimize(mst.Edges().data());
+    }
+  } catch (const std::runtime_error &e) {
+    state.SkipWithError(e.what());
+  }
+}
+static void BM_PrimEWD(benchmark::State &state, const char *path) {
+  try {
+    Graph graph = LoadEWDGraph(path);
+    for (auto _ : state) {
+      MST<> mst(graph);
+      benchmark::DoNotOptimize(mst.Edges().data());
+    }
+  } catch (const std::runtime_error &e) {
+    state.SkipWithError(e.what());
+  }
+}
+BENCHMARK_CAPTURE(BM_KruskalEWD, tiny, "tinyEWD.txt");
+BENCHMARK_CAPTURE(BM_PrimEWD, tiny, "tinyEWD.txt");
+BENCHMARK_CAPTURE(BM_KruskalEWD, medium, "mediumEWD.txt");
+BENCHMARK_CAPTURE(BM_PrimEWD, medium, "mediumEWD.txt");
+BENCHMARK_CAPTURE(BM_KruskalEWD, 1000, "1000EWD.txt");
+BENCHMARK_CAPTURE(BM_PrimEWD, 1000, "1000EWD.txt");
+BENCHMARK_CAPTURE(BM_KruskalEWD, 10000, "10000EWD.txt")
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_PrimEWD, 10000, "10000EWD.txt")
+  ->Unit(benchmark::kMillisecond);
+
+// Whole load of every bundled EWD file: map, parse, deduplicate and
+// build the CSR arrays, as prim_mst loads it
+static void BM_LoadEWD(benchmark::State &state, const char *path) {
+  try {
+    for (auto _ : state) {
+      Graph graph = LoadEWDGraph(path);
+      benchmark::DoNotOptimize(graph.Begin(0));
+    }
+  } catch (const std::runtime_error &e) {
+    state.SkipWithError(e.what());
+  }
+}
+BENCHMARK_CAPTURE(BM_LoadEWD, tiny, "tinyEWD.txt");
+BENCHMARK_CAPTURE(BM_LoadEWD, medium, "mediumEWD.txt");
+BENCHMARK_CAPTURE(BM_LoadEWD, 1000, "1000EWD.txt");
+BENCHMARK_CAPTURE(BM_LoadEWD, 10000, "10000EWD.txt")
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadEWD, empty, "emptyEWD.txt");
+BENCHMARK_CAPTURE(BM_LoadEWD, one, "oneEWD.txt");
+
+// End to end on 4096 random vertices by edges per vertex, from sparse to
+// half of the complete graph: CSR construction from the edge list, MST by
+// prim_mst's default choice of heap or array scan, and formatting
+static void BM_MSTDensity(benchmark::State &state) {
+  const Graph random = RandomGraph(1 << 12, state.range(0));
+  const std::vector<Edge> edges(random.Edges().begin(),
+                                random.Edges().end());
+  for (auto _ : state) {
+    Graph graph(1 << 12, edges);
+    MST<> mst(graph);
+    std::string text = FormatMST(mst.Result());
+    benchmark::DoNotOptimize(text.data());
+  }
+  state.counters["edges"] = edges.size();
+}
+BENCHMARK(BM_MSTDensity)
+  ->RangeMultiplier(4)->Range(2, 2048)
+  ->Unit(benchmark::kMillisecond);
+
+// Indexed heap against lazy deletion by edges per vertex on 4096 random
+// vertices: range(1) = 0 runs MST's d2 heap, 1 LazyPrimMST. Sparse graphs
+// push about one lazy entry per vertex; dense ones many stale entries
+// per vertex, against the indexed heap's ChangeKey calls
+static void BM_PrimLazyDensity(benchmark::State &state) {
+  Graph graph = RandomGraph(1 << 12, state.range(0));
+  for (auto _ : state) {
+    if (state.range(1)) {
+      LazyPrimMST mst(graph);
+      benchmark::DoNotOptimize(mst.Edges().data());
+    } else {
+      MST<> mst(graph, PrimMode::kHeap);
+      benchmark::DoNotOptimize(mst.Edges().data());
+    }
+  }
+}
+BENCHMARK(BM_PrimLazyDensity)
+  ->ArgsProduct({{2, 8, 32, 128, 512, 2048}, {0, 1}})
+  ->Unit(benchmark::kMillisecond);
+
+// Same, on the bundled 1000EWD and 10000EWD graphs
+static void BM_PrimLazyEWD(benchmark::State &state, const char *path,
+                           bool lazy) {
+  try {
+    Graph graph = LoadEWDGraph(path);
+    for (auto _ : state) {
+      if (lazy) {
+        LazyPrimMST mst(graph);
+        benchmark::DoNotOptimize(mst.Edges().data());
+      } else {
+        MST<> mst(graph, PrimMode::kHeap);
+        benchmark::DoNotOptimize(mst.Edges().data());
+      }
+    }
+  } catch (const std::runtime_error &e) {
+    state.SkipWithError(e.what());
+  }
+}
+BENCHMARK_CAPTURE(BM_PrimLazyEWD, 1000_heap, "1000EWD.txt", false);
+BENCHMARK_CAPTURE(BM_PrimLazyEWD, 1000_lazy, "1000EWD.txt", true);
+BENCHMARK_CAPTURE(BM_PrimLazyEWD, 10000_heap, "10000EWD.txt", false)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_PrimLazyEWD, 10000_lazy, "10000EWD.txt", true)
+  ->Unit(benchmark::kMillisecond);
+
+// Output formatting alone, on the forest of 10000EWD computed once
+static void BM_FormatMST(benchmark::State &state) {
+  try {
+    MST<> mst(LoadEWDGraph("10000EWD.txt"));
+    for (auto _ : state) {
+      std::string text = FormatMST(mst.Result());
+      benchmark::DoNotOptimize(text.data());
+      state.SetBytesProcessed(state.bytes_processed() + text.size());
+    }
+  } catch (const std::runtime_error &e) {
+    state.SkipWithError(e.what());
+  }
+}
+BENCHMARK(BM_FormatMST)->Unit(benchmark::kMillisecond);
+
+// Mixed stream on 10000EWD: a third each of deletions, weight changes and
+// insertions of random edges
+struct Update {
+  int kind;  // 0 delete, 1 reweight, 2 insert
+  unsigned int id;
+  Edge edge;
+};
+static std::vector<Update> UpdateStream(const Graph &graph, size_t count) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<unsigned int> vertex(0,
+                                                     graph.NumVertices() - 1);
+  std::uniform_real_distribution<double> weight(0.0, 1.0);
+  std::vector<bool> alive(graph.GetNumEdges(), true);
+  std::vector<Update> updates;
+  while (updates.size() < count) {
+    int kind = gen() % 3;
+    unsigned int id = gen() % alive.size();
+    if (kind < 2 && !alive[id])
+      continue;
+    if (kind == 0)
+      alive[id] = false;
+    if (kind == 2) {
+      id = alive.size();
+      alive.push_back(true);
+    }
+    updates.push_back(Update{kind, id,
+                             Edge(vertex(gen), vertex(gen), weight(gen))});
+  }
+  return updates;
+}
+
+// DynamicMST applying the stream, one update per item
+static void BM_DynamicUpdates(benchmark::State &state) {
+  Graph graph = LoadEWDGraph("10000EWD.txt");
+  std::vector<Update> updates = UpdateStream(graph, state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    DynamicMST mst(graph);
+    state.ResumeTiming();
+    for (const Update &u : updates) {
+      if (u.kind == 0)
+        mst.DeleteEdge(u.id);
+      else if (u.kind == 1)
+        mst.UpdateWeight(u.id, u.edge.Weight());
+      else
+        mst.AddEdge(u.edge);
+    }
+    benchmark::DoNotOptimize(mst.TotalWeight());
+  }
+  state.SetItemsProcessed(state.iterations() * updates.size());
+}
+BENCHMARK(BM_DynamicUpdates)->Arg(3000)->Unit(benchmark::kMillisecond);
+
+// The same stream, recomputing the forest with Kruskal's after each update
+static void BM_RecomputeUpdates(benchmark::State &state) {
+  Graph graph = LoadEWDGraph("10000EWD.txt");
+  std::vector<Update> updates = UpdateStream(graph, state.range(0));
+  for (auto _ : state) {
+    std::vector<Edge> edges(graph.Edges().begin(), graph.Edges().end());
+    std::vector<bool> alive(edges.size(), true);
+    for (const Update &u : updates) {
+      if (u.kind == 0) {
+        alive[u.id] = false;
+      } else if (u.kind == 1) {
+        edges[u.id] = Edge(edges[u.id].Source(), edges[u.id].Destination(),
+                           u.edge.Weight());
+      } else {
+        edges.push_back(u.edge);
+        alive.push_back(true);
+      }
+      std::vector<Edge> left;
+      for (size_t e = 0; e < edges.size(); e++) {
+        if (alive[e])
+          left.push_back(edges[e]);
+      }
+      KruskalMST mst(graph.NumVertices(), left);
+      benchmark::DoNotOptimize(mst.Edges().data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * updates.size());
+}
+BENCHMARK(BM_RecomputeUpdates)->Arg(30)->Unit(benchmark::kMillisecond);
+
+// Complete graph on @num_vertices vertices with random weights or, if
+// @adversarial, weights that fall with the lower endpoint so that every
+// vertex Prim's visits improves the distance of all remaining vertices
+static Graph CompleteGraph(unsigned int num_vertices, bool adversarial) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> weight(0.0, 1.0);
+  std::vector<Edge> edges;
+  edges.reserve(static_cast<size_t>(num_vertices) * (num_vertices - 1) / 2);
+  for (unsigned int u = 0; u < num_vertices; u++) {
+    for (unsigned int v = u + 1; v < num_vertices; v++) {
+      double w = adversarial ? 1.0 / (u + 1) + 1e-9 * weight(gen)
+                             : weight(gen);
+      edges.push_back(Edge(u, v, w));
+    }
+  }
+  return Graph(num_vertices, std::move(edges));
+}
+
+// Heap and array-scan Prim's on complete graphs
+static void BM_PrimComplete(benchmark::State &state) {
+  Graph graph = CompleteGraph(state.range(0), state.range(2));
+  PrimMode mode = state.range(1) ? PrimMode::kDense : PrimMode::kHeap;
+  for (auto _ : state) {
+    MST<> mst(graph, mode);
+    benchmark::DoNotOptimize(mst.Edges().data());
+  }
+}
+BENCHMARK(BM_PrimComplete)
+  ->ArgNames({"V", "dense", "adversarial"})
+  ->ArgsProduct({{1 << 10, 1 << 12}, {0, 1}, {0, 1}})
+  ->Unit(benchmark::kMillisecond);
+
+// EWD text for a random graph with @num_edges edge lines
+static std::string RandomEWD(unsigned int num_vertices, size_t num_edges) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<unsigned int> vertex(0, num_vertices - 1);
+  std::uniform_real_distribution<double> weight(0.0, 1.0);
+
+  std::string text = std::to_string(num_vertices) + "\n";
+  char line[64];
+  for (size_t i = 0; i < num_edges; i++) {
+    snprintf(line, sizeof(line), "%u %u %.5f\n", vertex(gen), vertex(gen),
+             weight(gen));
+    text += line;
+  }
+  return text;
+}
+
+// Parses [begin, end) once per iteration and reports bytes per second
+static void ParseThroughput(benchmark::State &state, const char *begin,
+                            const char *end) {
+  for (auto _ : state) {
+    EWDReader reader(begin, end);
+    std::vector<Edge> edges;
+    reader.ParseEdges(edges);
+    benchmark::DoNotOptimize(edges.data());
+  }
+  state.SetBytesProcessed(state.iterations() * (end - begin));
+}
+
+// Parse throughput on the largest bundled graph
+static void BM_ParseEWDFile(benchmark::State &state) {
+  try {
+    MappedFile file("10000EWD.txt");
+    ParseThroughput(state, file.Begin(), file.End());
+  } catch (const std::runtime_error &e) {
+    state.SkipWithError(e.what());
+  }
+}
+BENCHMARK(BM_ParseEWDFile)->Unit(benchmark::kMillisecond);
+
+// Parse throughput on synthetic text of growing size
+static void BM_ParseEWDSynthetic(benchmark::State &state) {
+  std::string text = RandomEWD(1000000, state.range(0));
+  ParseThroughput(state, text.data(), text.data() + text.size());
+}
+BENCHMARK(BM_ParseEWDSynthetic)
+  ->RangeMultiplier(10)->Range(100000, 1000000)
+  ->Unit(benchmark::kMillisecond);
+
+// Parse plus CSR construction split across state.range(0) threads; wall
+// time across the thread counts is the loader's scaling report
+static void BM_LoadParallel(benchmark::State &state) {
+  std::string text = RandomEWD(1000000, 4000000);
+  unsigned int threads = state.range(0);
+  for (auto _ : state) {
+    EWDReader reader(text.data(), text.data() + text.size());
+    std::vector<Edge> edges;
+    reader.ParseEdges(edges, threads);
+    Graph graph(reader.NumVertices(), std::move(edges), threads);
+    benchmark::DoNotOptimize(graph.Begin(0));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_LoadParallel)
+  ->RangeMultiplier(2)->Range(1, 16)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// @num_components disjoint copies of RandomGraph(@size, @degree), the
+// copies' vertices interleaved so that no component is a vertex range
+static Graph ManyComponents(unsigned int num_components, unsigned int size,
+                            unsigned int degree) {
+  Graph part = RandomGraph(size, degree);
+  std::vector<Edge> edges;
+  edges.reserve(part.GetNumEdges() * num_components);
+  for (unsigned int c = 0; c < num_components; c++) {
+    for (const Edge &e : part.Edges())
+      edges.push_back(Edge(e.Source() * num_components + c,
+                           e.Destination() * num_components + c,
+                           e.Weight()));
+  }
+  return Graph(num_components * size, std::move(edges));
+}
+
+// Per-component Prim's on 256 components of 4096 vertices by thread
+// count, against serial Prim's on the same graph for reference
+static void BM_ForestThreads(benchmark::State &state) {
+  static const Graph graph = ManyComponents(256, 4096, 8);
+  for (auto _ : state) {
+    ForestMST<> mst(graph, state.range(0));
+    benchmark::DoNotOptimize(mst.Edges().data());
+  }
+}
+BENCHMARK(BM_ForestThreads)
+  ->RangeMultiplier(2)->Range(1, 16)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_PrimManyComponents(benchmark::State &state) {
+  static const Graph graph = ManyComponents(256, 4096, 8);
+  for (auto _ : state) {
+    MST<> mst(graph);
+    benchmark::DoNotOptimize(mst.Edges().data());
+  }
+}
+BENCHMARK(BM_PrimManyComponents)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Borůvka on a 4M-edge random graph by thread count, against Prim's on
+// the same graph for reference
+static void BM_BoruvkaThreads(benchmark::State &state) {
+  static const Graph graph = RandomGraph(1 << 19, 8);
+  for (auto _ : state) {
+    BoruvkaMST mst(graph, state.range(0));
+    benchmark::DoNotOptimize(mst.Edges().data());
+  }
+}
+BENCHMARK(BM_BoruvkaThreads)
+  ->RangeMultiplier(2)->Range(1, 16)
+  ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_PrimLarge(benchmark::State &state) {
+  static const Graph graph = RandomGraph(1 << 19, 8);
+  for (auto _ : state) {
+    MST<> mst(graph);
+    benchmark::DoNotOptimize(mst.Edges().data());
+  }
+}
+BENCHMARK(BM_PrimLarge)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// @side x @side grid with random weights whose vertex ids are shuffled,
+// like the arbitrary ids of the EWD files: neighbors in the plane are far
+// apart in memory until relabeled
+static Graph ShuffledGrid(unsigned int side) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> weight(0.0, 1.0);
+  std::vector<unsigned int> id(side * side);
+  for (unsigned int v = 0; v < id.size(); v++)
+    id[v] = v;
+  std::shuffle(id.begin(), id.end(), gen);
+
+  std::vector<Edge> edges;
+  for (unsigned int r = 0; r < side; r++) {
+    for (unsigned int c = 0; c < side; c++) {
+      unsigned int v = r * side + c;
+      if (c + 1 < side)
+        edges.push_back(Edge(id[v], id[v + 1], weight(gen)));
+      if (r + 1 < side)
+        edges.push_back(Edge(id[v], id[v + side], weight(gen)));
+    }
+  }
+  return Graph(side * side, std::move(edges));
+}
+
+// Prim's on @graph relabeled in VertexOrder state.range(0), relabeling
+// not timed, with cache misses per iteration where the hardware counts
+static void PrimOrdered(benchmark::State &state, const Graph &graph) {
+  VertexOrder order = static_cast<VertexOrder>(state.range(0));
+  Graph relabeled = RelabelGraph(graph, VertexLabels(graph, order));
+  CacheCounters counters;
+  uint64_t references = 0, misses = 0;
+  for (auto _ : state) {
+    counters.Start();
+    MST<> mst(relabeled);
+    counters.Stop();
+    benchmark::DoNotOptimize(mst.Edges().data());
+    references += counters.References();
+    misses += counters.Misses();
+  }
+  if (counters.Available()) {
+    state.counters["cache_refs"] =
+        benchmark::Counter(references, benchmark::Counter::kAvgIterations);
+    state.counters["cache_misses"] =
+        benchmark::Counter(misses, benchmark::Counter::kAvgIterations);
+  }
+}
+
+// by order: 0 none, 1 BFS, 2 RCM, 3 degree
+static void BM_PrimOrderEWD(benchmark::State &state) {
+  static const Graph graph = LoadEWDGraph("10000EWD.txt");
+  PrimOrdered(state, graph);
+}
+BENCHMARK(BM_PrimOrderEWD)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+
+static void BM_PrimOrderGrid(benchmark::State &state) {
+  static const Graph graph = ShuffledGrid(1024);
+  PrimOrdered(state, graph);
+}
+BENCHMARK(BM_PrimOrderGrid)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+
+static void BM_PrimOrderRandom(benchmark::State &state) {
+  static const Graph graph = RandomGraph(1 << 19, 8);
+  PrimOrdered(state, graph);
+}
+BENCHMARK(BM_PrimOrderRandom)
+  ->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+
+// cost of the relabeling itself, by order
+static void BM_RelabelGrid(benchmark::State &state) {
+  static const Graph graph = ShuffledGrid(1024);
+  VertexOrder order = static_cast<VertexOrder>(state.range(0));
+  for (auto _ : state) {
+    Graph relabeled = RelabelGraph(graph, VertexLabels(graph, order));
+    benchmark::DoNotOptimize(relabeled.Edges().data());
+  }
+}
+BENCHMARK(BM_RelabelGrid)->DenseRange(1, 3)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,124 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef BORUVKA_MST_H_
+#define BORUVKA_MST_H_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "graph.h"
+#include "mst.h"
+#include "mst_result.h"
+#include "parallel.h"
+#include "union_find.h"
+
+// BORUVKA MIN SPANNING TREE CLASS
+// Minimum spanning forest by parallel Borůvka rounds: every component
+// picks its lightest outgoing edge, all picks are merged through a
+// concurrent union-find, and edges inside one component are dropped.
+//
+// Edges are ordered by (weight, edge id), so the forest is unique and the
+// same for any thread count. It is laid out like MST::Edges(): each tree
+// is rooted at its lowest vertex and edge[v] links v to its parent. This
+// is exactly Prim's output, which breaks ties by edge id too (PrimKey).
+class BoruvkaMST {
+ public:
+  // computes the minimum spanning forest of @graph on @num_threads threads
+  explicit BoruvkaMST(const Graph &graph, unsigned int num_threads = 1);
+  // return the computed forest
+  const MSTResult &Result() const {
+    return result;
+  }
+  // return the edge that connects each vertex to the tree
+  const std::vector<Edge> &Edges() const {
+    return result.Edges();
+  }
+  // print out the tree edges and total weight
+  void Print(OutputMode mode = OutputMode::kFull) const {
+    PrintMST(result, mode);
+  }
+
+ private:
+  static constexpr unsigned int kNone = ~0U;
+
+  MSTResult result;
+
+  // Return ids of the forest edges
+  static std::vector<unsigned int> Forest(const Graph &graph,
+                                          unsigned int num_threads);
+};
+
+inline BoruvkaMST::BoruvkaMST(const Graph &graph, unsigned int num_threads) {
+  result = MSTResult(RootForest(graph.NumVertices(), graph.Edges(),
+                                Forest(graph, num_threads)));
+}
+
+inline std::vector<unsigned int> BoruvkaMST::Forest(const Graph &graph,
+                                                    unsigned int num_threads) {
+  const EdgeSpan edges = graph.Edges();
+  const size_t n = graph.NumVertices();
+  // whether edge a comes before edge b in the (weight, id) order
+  auto lighter = [&edges](unsigned int a, unsigned int b) {
+    return edges[a].Weight() < edges[b].Weight() ||
+        (edges[a].Weight() == edges[b].Weight() && a < b);
+  };
+
+  ConcurrentUnionFind components(n);
+  std::vector<std::atomic<unsigned int>> best(n);  // lightest edge per root
+  for (std::atomic<unsigned int> &b : best)
+    b.store(kNone, std::memory_order_relaxed);
+  std::vector<unsigned int> active(edges.size());  // edges between components
+  for (unsigned int e = 0; e < active.size(); e++)
+    active[e] = e;
+
+  std::vector<std::vector<unsigned int>> kept(num_threads);
+  std::vector<std::vector<unsigned int>> picked(num_threads);
+  while (!active.empty()) {
+    // 1. Every edge between two components offers itself to both, and
+    // survives to the next round
+    ParallelFor(num_threads, [&](unsigned int t) {
+      kept[t].clear();
+      size_t end = ChunkBegin(active.size(), t + 1, num_threads);
+      for (size_t i = ChunkBegin(active.size(), t, num_threads); i < end;
+           i++) {
+        unsigned int e = active[i];
+        unsigned int cu = components.Find(edges[e].Source());
+        unsigned int cv = components.Find(edges[e].Destination());
+        if (cu == cv)
+          continue;
+        kept[t].push_back(e);
+        for (unsigned int c : {cu, cv}) {
+          unsigned int cur = best[c].load(std::memory_order_relaxed);
+          while ((cur == kNone || lighter(e, cur)) &&
+                 !best[c].compare_exchange_weak(cur, e,
+                                                std::memory_order_relaxed)) {}
+        }
+      }
+    });
+
+    // 2. Merge along every pick; two components picking the same edge
+    // merge once, so each forest edge is picked by one thread only
+    ParallelFor(num_threads, [&](unsigned int t) {
+      size_t end = ChunkBegin(n, t + 1, num_threads);
+      for (size_t c = ChunkBegin(n, t, num_threads); c < end; c++) {
+        unsigned int e = best[c].load(std::memory_order_relaxed);
+        if (e == kNone)
+          continue;
+        best[c].store(kNone, std::memory_order_relaxed);
+        if (components.Union(edges[e].Source(), edges[e].Destination()))
+          picked[t].push_back(e);
+      }
+    });
+
+    active.clear();
+    for (std::vector<unsigned int> &part : kept)
+      active.insert(active.end(), part.begin(), part.end());
+  }
+
+  std::vector<unsigned int> forest;
+  for (std::vector<unsigned int> &part : picked)
+    forest.insert(forest.end(), part.begin(), part.end());
+  return forest;
+}
+
+#endif  // BORUVKA_MST_H_
@@ -0,0 +1,327 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef COMPACT_GRAPH_H_
+#define COMPACT_GRAPH_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "graph.h"
+#include "index_min_pq.h"
+#include "mst.h"
+#include "mst_result.h"
+#include "prim_key.h"
+
+// Compact adjacency storage for graphs too large for Graph, which keeps
+// the 16-byte input edge list plus three arrays per adjacency entry (32
+// bytes per edge more). CompactGraph keeps only the entries: the owning
+// vertex is implicit in the offsets, each entry holds its neighbor and a
+// weight of type W, and nothing else. The neighbor encoding is the
+// Neighbors parameter:
+//
+//   PlainNeighbors  4 bytes per entry
+//   DeltaNeighbors  varint gaps between neighbors, 1-2 bytes per entry
+//                   on graphs with local ids
+//
+// Parallel edges and self-loops are dropped while building, by sorting
+// each vertex's entries by neighbor, so the input needs no DedupEdges and
+// its hash table (32 bytes per edge, the peak of a Graph load). Nor does
+// it need an edge list: the graph can be built from a stream of edges,
+// read twice, such as the EWD text itself.
+//
+// With W = float a graph takes 8 bytes per entry (16 per edge) plain, and
+// about 6 delta encoded, against 48 per edge for Graph.
+//
+// Float tolerance: rounding a weight to float moves it by at most 2^-24
+// of its value. With nonnegative weights every tree's float weight is
+// within 2^-24 of its true weight, so the minimum spanning forest found on
+// float weights weighs at most 2^-23 (about 1.2e-7) of the total more than
+// the true minimum, and the printed total differs at most by that much.
+// Weights equal as floats but not as doubles may also pick different
+// edges of equal printed weight. A weight that rounds to infinity (above
+// FLT_MAX for float) would read as no edge at all, so the build refuses
+// it with std::runtime_error.
+
+// Entries pack the neighbor in the low 31 bits and, in the top bit,
+// whether the owning vertex is the source of the input edge, so that tree
+// edges come out in their input orientation
+static constexpr uint32_t kCompactSourceBit = 1U << 31;
+
+// PLAIN NEIGHBORS CLASS
+// One packed 32-bit entry per adjacency entry.
+class PlainNeighbors {
+ public:
+  PlainNeighbors() {}
+  // stores @entries, the entries of vertex u at [offsets[u], offsets[u+1])
+  PlainNeighbors(std::vector<uint32_t> entries, const std::vector<size_t> &)
+    : entries(std::move(entries)) {}
+  // calls @fn(i, entry) for the entries i in [begin, end) of vertex @u
+  template <typename Fn>
+  void ForEach(unsigned int, size_t begin, size_t end, Fn fn) const {
+    for (size_t i = begin; i < end; i++)
+      fn(i, entries[i]);
+  }
+  // return bytes held
+  size_t Bytes() const {
+    return entries.capacity() * sizeof(uint32_t);
+  }
+
+ private:
+  std::vector<uint32_t> entries;
+};
+
+// DELTA NEIGHBORS CLASS
+// The entries of each vertex, sorted by neighbor, as LEB128 varints of
+// (gap << 1 | source bit), the gap taken from the previous neighbor (from
+// 0 for the first).
+class DeltaNeighbors {
+ public:
+  DeltaNeighbors() {}
+  // encodes @entries, the entries of vertex u at [offsets[u], offsets[u+1])
+  // in neighbor order
+  DeltaNeighbors(std::vector<uint32_t> entries,
+                 const std::vector<size_t> &offsets);
+  // calls @fn(i, entry) for the entries i in [begin, end) of vertex @u
+  template <typename Fn>
+  void ForEach(unsigned int u, size_t begin, size_t end, Fn fn) const {
+    const uint8_t *p = bytes.data() + starts[u];
+    uint32_t neighbor = 0;
+    for (size_t i = begin; i < end; i++) {
+      uint64_t value = 0;
+      for (unsigned int shift = 0;; shift += 7) {
+        uint8_t byte = *p++;
+        value |= uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+          break;
+      }
+      neighbor += value >> 1;
+      fn(i, neighbor | ((value & 1) ? kCompactSourceBit : 0));
+    }
+  }
+  // return bytes held
+  size_t Bytes() const {
+    return bytes.capacity() + starts.capacity() * sizeof(size_t);
+  }
+
+ private:
+  std::vector<uint8_t> bytes;
+  std::vector<size_t> starts;  // byte offset of each vertex's entries
+};
+
+inline DeltaNeighbors::DeltaNeighbors(std::vector<uint32_t> entries,
+                                      const std::vector<size_t> &offsets)
+  : starts(offsets.size()) {
+  bytes.reserve(entries.size() * 2);
+  for (size_t u = 0; u + 1 < offsets.size(); u++) {
+    starts[u] = bytes.size();
+    uint32_t previous = 0;
+    for (size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+      uint32_t neighbor = entries[i] & ~kCompactSourceBit;
+      uint64_t value = uint64_t(neighbor - previous) << 1 |
+          ((entries[i] & kCompactSourceBit) ? 1 : 0);
+      previous = neighbor;
+      do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        bytes.push_back(value ? byte | 0x80 : byte);
+      } while (value);
+    }
+  }
+  starts.back() = bytes.size();
+  bytes.shrink_to_fit();
+}
+
+// One adjacency entry of a CompactGraph
+struct CompactArc {
+  unsigned int vertex;  // the other endpoint
+  double weight;
+  bool source;          // whether the owning vertex is the input source
+};
+
+// COMPACT GRAPH CLASS
+// Undirected graph as adjacency entries of W weights and Neighbors
+// encoded neighbors; see above.
+template <typename W = float, typename Neighbors = PlainNeighbors>
+class CompactGraph {
+ public:
+  // builds the graph of @num_vertices vertices and the distinct edges of
+  // @edge_list, which is released once scattered; throws
+  // std::runtime_error on a weight W cannot hold
+  CompactGraph(size_t num_vertices, std::vector<Edge> edge_list);
+  // same for the edges @for_each_edge(fn) streams, calling fn(edge) for
+  // every edge; it is called twice and must stream the same edges both
+  // times
+  template <typename ForEachEdge>
+  static CompactGraph FromStream(size_t num_vertices,
+                                 ForEachEdge for_each_edge);
+  // return number of vertices
+  size_t NumVertices() const {
+    return offsets.size() - 1;
+  }
+  // return number of (undirected) edges
+  size_t GetNumEdges() const {
+    return weights.size() / 2;
+  }
+  // calls @fn(arc) for every adjacency entry of @u
+  template <typename Fn>
+  void ForEachArc(unsigned int u, Fn fn) const {
+    neighbors.ForEach(u, offsets[u], offsets[u + 1],
+                      [&](size_t i, uint32_t entry) {
+                        fn(CompactArc{entry & ~kCompactSourceBit,
+                                      weights[i],
+                                      (entry & kCompactSourceBit) != 0});
+                      });
+  }
+  // return the edge of adjacency entry @arc of @u, in input orientation
+  Edge ArcEdge(unsigned int u, const CompactArc &arc) const {
+    return arc.source ? Edge(u, arc.vertex, arc.weight)
+                      : Edge(arc.vertex, u, arc.weight);
+  }
+  // return 0: compact storage keeps no edge ids, so Prim's on it breaks
+  // ties among equal weights by queue order only
+  unsigned int ArcId(unsigned int, const CompactArc &) const {
+    return 0;
+  }
+  // return bytes held by the graph
+  size_t Bytes() const {
+    return offsets.capacity() * sizeof(size_t) +
+        weights.capacity() * sizeof(W) + neighbors.Bytes();
+  }
+
+ private:
+  std::vector<size_t> offsets;  // size num_vertices + 1
+  std::vector<W> weights;       // size 2 * num_edges
+  Neighbors neighbors;
+
+  explicit CompactGraph(size_t num_vertices);
+  // Steps 1 and 2 of the build: return the entries of the edges
+  // @for_each_edge streams, scattered under both endpoints, their
+  // weights in @weights
+  template <typename ForEachEdge>
+  std::vector<uint32_t> Scatter(ForEachEdge for_each_edge);
+  // Step 3: drops repeated neighbors from @entries and encodes them
+  void Compact(std::vector<uint32_t> entries);
+};
+
+template <typename W, typename Neighbors>
+CompactGraph<W, Neighbors>::CompactGraph(size_t num_vertices)
+  : offsets(num_vertices + 1, 0) {
+  if (num_vertices > kCompactSourceBit)
+    throw std::runtime_error("Error: compact storage holds at most 2^31 "
+                             "vertices");
+}
+
+template <typename W, typename Neighbors>
+CompactGraph<W, Neighbors>::CompactGraph(size_t num_vertices,
+                                         std::vector<Edge> edge_list)
+  : CompactGraph(num_vertices) {
+  std::vector<uint32_t> entries = Scatter([&edge_list](auto fn) {
+    for (const Edge &e : edge_list)
+      fn(e);
+  });
+  std::vector<Edge>().swap(edge_list);
+  Compact(std::move(entries));
+}
+
+template <typename W, typename Neighbors>
+template <typename ForEachEdge>
+CompactGraph<W, Neighbors> CompactGraph<W, Neighbors>::FromStream(
+    size_t num_vertices, ForEachEdge for_each_edge) {
+  CompactGraph graph(num_vertices);
+  graph.Compact(graph.Scatter(for_each_edge));
+  return graph;
+}
+
+template <typename W, typename Neighbors>
+template <typename ForEachEdge>
+std::vector<uint32_t> CompactGraph<W, Neighbors>::Scatter(
+    ForEachEdge for_each_edge) {
+  const size_t num_vertices = NumVertices();
+
+  // 1. Degrees, then their prefix sums
+  for_each_edge([&](const Edge &e) {
+    if (e.Source() != e.Destination()) {
+      offsets[e.Source() + 1]++;
+      offsets[e.Destination() + 1]++;
+    }
+  });
+  for (size_t v = 0; v < num_vertices; v++)
+    offsets[v + 1] += offsets[v];
+
+  // 2. Scatter each edge under both endpoints, preserving input order
+  weights.resize(offsets[num_vertices]);
+  std::vector<uint32_t> entries(weights.size());
+  std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+  for_each_edge([&](const Edge &e) {
+    if (e.Source() == e.Destination())
+      return;
+    const W weight = static_cast<W>(e.Weight());
+    if (!std::isfinite(weight))
+      throw std::runtime_error("Error: edge weight too large for compact "
+                               "storage");
+    size_t i = cursor[e.Source()]++;
+    entries[i] = e.Destination() | kCompactSourceBit;
+    weights[i] = weight;
+    size_t j = cursor[e.Destination()]++;
+    entries[j] = e.Source();
+    weights[j] = weight;
+  });
+  return entries;
+}
+
+template <typename W, typename Neighbors>
+void CompactGraph<W, Neighbors>::Compact(std::vector<uint32_t> entries) {
+  const size_t num_vertices = NumVertices();
+
+  // 3. Each vertex's entries in neighbor order, keeping the lightest of
+  // equal neighbors (the first among equal weights) as DedupEdges does;
+  // the blocks only shrink, so they are compacted in place
+  std::vector<std::pair<uint32_t, W>> block;
+  size_t kept = 0;
+  for (size_t u = 0; u < num_vertices; u++) {
+    block.clear();
+    for (size_t i = offsets[u]; i < offsets[u + 1]; i++)
+      block.emplace_back(entries[i], weights[i]);
+    std::stable_sort(block.begin(), block.end(),
+                     [](const std::pair<uint32_t, W> &a,
+                        const std::pair<uint32_t, W> &b) {
+                       return (a.first & ~kCompactSourceBit) <
+                           (b.first & ~kCompactSourceBit);
+                     });
+    offsets[u] = kept;
+    for (size_t k = 0; k < block.size(); k++) {
+      if (k > 0 && !((block[k].first ^ block[k - 1].first) &
+                     ~kCompactSourceBit)) {
+        if (block[k].second < weights[kept - 1]) {
+          entries[kept - 1] = block[k].first;
+          weights[kept - 1] = block[k].second;
+        }
+        continue;
+      }
+      entries[kept] = block[k].first;
+      weights[kept++] = block[k].second;
+    }
+  }
+  offsets[num_vertices] = kept;
+  entries.resize(kept);
+  entries.shrink_to_fit();
+  weights.resize(kept);
+  weights.shrink_to_fit();
+  neighbors = Neighbors(std::move(entries), offsets);
+}
+
+// Return the minimum spanning forest of @graph, a CompactGraph, by Prim's
+// on queue PQ, growing the trees in the same order as MST. Only the order
+// of adjacency entries differs, so the edges picked differ only between
+// equal weights, including those made equal by float rounding.
+template <typename PQ = IndexMinPQ<PrimKey>, typename G>
+MSTResult CompactPrim(const G &graph) {
+  PQ pqueue(graph.NumVertices());
+  return MSTResult(PrimForest(graph, pqueue));
+}
+
+#endif  // COMPACT_GRAPH_H_
@@ -0,0 +1,274 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef DYNAMIC_MST_H_
+#define DYNAMIC_MST_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "graph.h"
+#include "link_cut_tree.h"
+#include "mst.h"
+#include "mst_result.h"
+
+// DYNAMIC MIN SPANNING TREE CLASS
+// Minimum spanning forest of a graph whose edges are added, deleted and
+// reweighted. Edges keep the ids they have in graph.Edges(); added edges
+// get the next ids.
+//
+// The forest lives in a link-cut tree as in IncrementalMST (one node per
+// vertex and one per edge, tree edges linked between their endpoints), so
+// insertions and weight decreases swap out the heaviest edge of a tree
+// path in O(log V). When a tree edge is deleted or gets heavier, the
+// replacement is the lightest non-tree edge leaving the smaller of the
+// two halves. Two breadth first searches over tree edges, one from each
+// end, advance in turn until one half is exhausted, so the cost is the
+// edges incident to the smaller half: small for most cuts, O(E) at worst.
+// (A Holm-de Lichtenberg-Thorup level structure would bound it by
+// O(log^2 V) amortized, at a much larger constant.)
+class DynamicMST {
+ public:
+  // computes the minimum spanning forest of @graph
+  explicit DynamicMST(const Graph &graph);
+  // adds edge @e to the graph, return its id
+  unsigned int AddEdge(const Edge &e);
+  // removes edge @id from the graph
+  void DeleteEdge(unsigned int id);
+  // sets the weight of edge @id to @weight
+  void UpdateWeight(unsigned int id, double weight);
+  // return whether edge @id is in the graph
+  bool Contains(unsigned int id) const {
+    return id < edges.size() && state[id] != kDeleted;
+  }
+  // return whether edge @id is in the forest
+  bool InTree(unsigned int id) const {
+    return id < edges.size() && state[id] == kTree;
+  }
+  // return number of vertices
+  size_t NumVertices() const {
+    return num_vertices;
+  }
+  // return sum of the tree edge weights, updated on every change
+  double TotalWeight() const {
+    return total_weight;
+  }
+  // return the current forest laid out like MST's
+  MSTResult Result() const;
+
+ private:
+  enum State : unsigned char { kTree, kWaiting, kDeleted };
+  static constexpr unsigned int kNone = ~0U;
+
+  size_t num_vertices;
+  LinkCutTree forest;  // vertex v is node v, edge i is node n + i
+  std::vector<Edge> edges;
+  std::vector<State> state;
+  std::vector<std::vector<unsigned int>> incident;  // edge ids per vertex
+  double total_weight;
+  // Replace's scratch: side[v] == mark + s if v was reached from end s
+  std::vector<size_t> side;
+  size_t mark;
+  std::vector<unsigned int> queue[2];
+
+  // Return node of edge @id
+  unsigned int Node(unsigned int id) const {
+    return num_vertices + id;
+  }
+  // Throws unless edge @id is in the graph
+  void Check(unsigned int id) const {
+    if (!Contains(id))
+      throw std::runtime_error("Invalid edge id " + std::to_string(id));
+  }
+  void Link(unsigned int id);
+  void Unlink(unsigned int id);
+  // Puts edge @id into the forest if it belongs there
+  void Insert(unsigned int id);
+  // Links the lightest non-tree edge between the trees of @a and @b, just
+  // split by the removal of a tree edge, if there is one
+  void Replace(unsigned int a, unsigned int b);
+};
+
+inline DynamicMST::DynamicMST(const Graph &graph)
+  : num_vertices(graph.NumVertices()),
+    forest(graph.NumVertices()),
+    incident(graph.NumVertices()),
+    total_weight(0),
+    side(graph.NumVertices(), 0),
+    mark(1) {
+  // Kruskal's order: then Insert never has to swap an edge out
+  std::vector<unsigned int> order(graph.GetNumEdges());
+  for (unsigned int id = 0; id < order.size(); id++)
+    order[id] = id;
+  const EdgeSpan graph_edges = graph.Edges();
+  std::sort(order.begin(), order.end(),
+            [&graph_edges](unsigned int a, unsigned int b) {
+              return graph_edges[a].Weight() < graph_edges[b].Weight() ||
+                  (graph_edges[a].Weight() == graph_edges[b].Weight() &&
+                   a < b);
+            });
+
+  edges.assign(graph_edges.begin(), graph_edges.end());
+  state.assign(edges.size(), kWaiting);
+  for (unsigned int id = 0; id < edges.size(); id++) {
+    forest.AddNode(edges[id].Weight());
+    incident[edges[id].Source()].push_back(id);
+    if (edges[id].Destination() != edges[id].Source())
+      incident[edges[id].Destination()].push_back(id);
+  }
+  for (unsigned int id : order)
+    Insert(id);
+}
+
+inline void DynamicMST::Link(unsigned int id) {
+  forest.Link(edges[id].Source(), Node(id));
+  forest.Link(Node(id), edges[id].Destination());
+  state[id] = kTree;
+  total_weight += edges[id].Weight();
+}
+
+inline void DynamicMST::Unlink(unsigned int id) {
+  forest.Cut(edges[id].Source(), Node(id));
+  forest.Cut(Node(id), edges[id].Destination());
+  total_weight -= edges[id].Weight();
+}
+
+inline void DynamicMST::Insert(unsigned int id) {
+  const Edge &e = edges[id];
+  if (e.Source() != e.Destination() &&
+      !forest.Connected(e.Source(), e.Destination())) {
+    Link(id);
+    return;
+  }
+
+  if (e.Source() != e.Destination()) {
+    // the heaviest node on a path between two vertices is an edge node
+    unsigned int heaviest = forest.PathMax(e.Source(), e.Destination());
+    if (e.Weight() < forest.Weight(heaviest)) {
+      unsigned int old = heaviest - num_vertices;
+      Unlink(old);
+      state[old] = kWaiting;
+      Link(id);
+      return;
+    }
+  }
+  state[id] = kWaiting;
+}
+
+inline void DynamicMST::Replace(unsigned int a, unsigned int b) {
+  // 1. Search both halves in turn until one runs out
+  mark += 2;
+  const unsigned int end[2] = {a, b};
+  size_t head[2] = {0, 0};
+  for (int s = 0; s < 2; s++) {
+    queue[s].assign(1, end[s]);
+    side[end[s]] = mark + s;
+  }
+  int small = 0;
+  for (int s = 0;; s = 1 - s) {
+    if (head[s] == queue[s].size()) {
+      small = s;
+      break;
+    }
+    unsigned int u = queue[s][head[s]++];
+    for (unsigned int id : incident[u]) {
+      if (state[id] != kTree)
+        continue;
+      unsigned int v = edges[id].Source() == u ? edges[id].Destination()
+                                               : edges[id].Source();
+      if (side[v] != mark + s) {
+        side[v] = mark + s;
+        queue[s].push_back(v);
+      }
+    }
+  }
+
+  // 2. Lightest non-tree edge leaving the small half
+  unsigned int best = kNone;
+  for (unsigned int u : queue[small]) {
+    for (unsigned int id : incident[u]) {
+      if (state[id] != kWaiting)
+        continue;
+      unsigned int v = edges[id].Source() == u ? edges[id].Destination()
+                                               : edges[id].Source();
+      if (side[v] == mark + small)
+        continue;
+      if (best == kNone || edges[id].Weight() < edges[best].Weight() ||
+          (edges[id].Weight() == edges[best].Weight() && id < best))
+        best = id;
+    }
+  }
+  if (best != kNone)
+    Link(best);
+}
+
+inline unsigned int DynamicMST::AddEdge(const Edge &e) {
+  for (unsigned int v : {e.Source(), e.Destination()}) {
+    if (v >= num_vertices)
+      throw std::runtime_error("Invalid vertex number " + std::to_string(v));
+  }
+  unsigned int id = edges.size();
+  edges.push_back(e);
+  state.push_back(kWaiting);
+  forest.AddNode(e.Weight());
+  incident[e.Source()].push_back(id);
+  if (e.Destination() != e.Source())
+    incident[e.Destination()].push_back(id);
+  Insert(id);
+  return id;
+}
+
+inline void DynamicMST::DeleteEdge(unsigned int id) {
+  Check(id);
+  bool tree = state[id] == kTree;
+  if (tree)
+    Unlink(id);
+  state[id] = kDeleted;
+  for (unsigned int v : {edges[id].Source(), edges[id].Destination()}) {
+    std::vector<unsigned int> &ids = incident[v];
+    auto it = std::find(ids.begin(), ids.end(), id);
+    if (it != ids.end()) {
+      *it = ids.back();
+      ids.pop_back();
+    }
+  }
+  if (tree)
+    Replace(edges[id].Source(), edges[id].Destination());
+}
+
+inline void DynamicMST::UpdateWeight(unsigned int id, double weight) {
+  Check(id);
+  const Edge old = edges[id];
+  edges[id] = Edge(old.Source(), old.Destination(), weight);
+
+  if (state[id] == kTree) {
+    total_weight += weight - old.Weight();
+    forest.SetWeight(Node(id), weight);
+    // a lighter tree edge stays; a heavier one competes with the edges
+    // across the cut it spans, itself included
+    if (weight > old.Weight()) {
+      Unlink(id);
+      state[id] = kWaiting;
+      Replace(old.Source(), old.Destination());
+    }
+    return;
+  }
+
+  forest.SetWeight(Node(id), weight);
+  // a heavier waiting edge keeps waiting; a lighter one may displace the
+  // heaviest edge of its tree path
+  Insert(id);
+}
+
+inline MSTResult DynamicMST::Result() const {
+  std::vector<unsigned int> ids;
+  for (unsigned int id = 0; id < edges.size(); id++) {
+    if (state[id] == kTree)
+      ids.push_back(id);
+  }
+  return MSTResult(RootForest(num_vertices, edges, ids));
+}
+
+#endif  // DYNAMIC_MST_H_
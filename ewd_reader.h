@@ -0,0 +1,212 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef EWD_READER_H_
+#define EWD_READER_H_
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "mapped_file.h"
+#include "parallel.h"
+
+// PARSE ERROR CLASS
+// Malformed input, located by 1-based line and column
+class ParseError : public std::runtime_error {
+ public:
+  ParseError(const std::string &what, size_t line, size_t column)
+    : std::runtime_error(what + " (line " + std::to_string(line) +
+                         ", column " + std::to_string(column) + ")"),
+      line(line), column(column) {}
+  // return line of the error
+  size_t Line() const {
+    return line;
+  }
+  // return column of the error
+  size_t Column() const {
+    return column;
+  }
+
+ private:
+  size_t line, column;
+};
+
+// EWD READER CLASS
+// Scanner for EWD text: the vertex count on the first line, then one
+// "source destination weight" triple per line. Numbers are converted with
+// std::from_chars, so parsing is locale-free and never copies the input.
+class EWDReader {
+ public:
+  // reads the header of the text in [begin, end)
+  EWDReader(const char *begin, const char *end);
+  // return number of vertices announced by the header
+  size_t NumVertices() const {
+    return num_vertices;
+  }
+  // return start of the first edge line
+  const char *Body() const {
+    return body;
+  }
+  // parses the whole lines in [from, to) and appends their edges to @edges
+  void ParseEdges(const char *from, const char *to,
+                  std::vector<Edge> &edges) const;
+  // parses the whole lines in [from, to), calling @fn(edge) for each edge
+  template <typename Fn>
+  void ForEachEdge(const char *from, const char *to, Fn fn) const;
+  // parses every edge line, calling @fn(edge) for each edge in file order,
+  // without storing any
+  template <typename Fn>
+  void ForEachEdge(Fn fn) const {
+    ForEachEdge(body, end, fn);
+  }
+  // parses every edge line and appends the edges to @edges, in file
+  // order. With several threads the body is cut into chunks at line
+  // boundaries, each chunk is parsed into its own buffer and the buffers
+  // are concatenated; the result and any error reported are the same as
+  // with one thread.
+  void ParseEdges(std::vector<Edge> &edges,
+                  unsigned int num_threads = 1) const;
+
+ private:
+  const char *begin, *end, *body;
+  size_t num_vertices;
+
+  // Helper methods for scanning
+  static bool IsBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+  }
+  static const char *SkipBlanks(const char *p, const char *to) {
+    while (p != to && IsBlank(*p))
+      p++;
+    return p;
+  }
+  static const char *SkipSpace(const char *p, const char *to) {
+    while (p != to && (IsBlank(*p) || *p == '\n'))
+      p++;
+    return p;
+  }
+  // Reads an unsigned vertex number at @p, checks it against the header
+  const char *ReadVertex(const char *p, const char *to, const char *name,
+                         unsigned int &vertex) const;
+
+  // Throws a ParseError located at @at
+  [[noreturn]] void Fail(const std::string &what, const char *at) const {
+    size_t line = 1 + std::count(begin, at, '\n');
+    const char *line_start = at;
+    while (line_start != begin && line_start[-1] != '\n')
+      line_start--;
+    throw ParseError(what, line, at - line_start + 1);
+  }
+};
+
+inline EWDReader::EWDReader(const char *begin, const char *end)
+  : begin(begin), end(end) {
+  // header holds the number of vertices and nothing else
+  const char *p = SkipBlanks(begin, end);
+  unsigned long count = 0;
+  std::from_chars_result r = std::from_chars(p, end, count);
+  const char *q = SkipBlanks(r.ptr, end);
+  if (r.ec != std::errc() || count > ~0U || (q != end && *q != '\n'))
+    Fail("Error: invalid graph size", p);
+  num_vertices = count;
+  body = q;
+}
+
+inline const char *EWDReader::ReadVertex(const char *p, const char *to,
+                                         const char *name,
+                                         unsigned int &vertex) const {
+  unsigned long value = 0;
+  std::from_chars_result r = std::from_chars(p, to, value);
+  if (r.ec != std::errc())
+    Fail(std::string("Malformed ") + name + " vertex", p);
+  if (value >= num_vertices)
+    Fail(std::string("Invalid ") + name + " vertex number " +
+         std::to_string(value), p);
+  vertex = value;
+  return r.ptr;
+}
+
+inline void EWDReader::ParseEdges(const char *from, const char *to,
+                                  std::vector<Edge> &edges) const {
+  ForEachEdge(from, to, [&edges](const Edge &e) { edges.push_back(e); });
+}
+
+template <typename Fn>
+void EWDReader::ForEachEdge(const char *from, const char *to, Fn fn) const {
+  const char *p = SkipSpace(from, to);
+  while (p != to) {
+    unsigned int source, destination;
+    double weight;
+
+    p = ReadVertex(p, to, "source", source);
+    if (p == to || !IsBlank(*p))
+      Fail("Expected destination vertex", p);
+    p = ReadVertex(SkipBlanks(p, to), to, "destination", destination);
+    if (p == to || !IsBlank(*p))
+      Fail("Expected weight", p);
+
+    p = SkipBlanks(p, to);
+    std::from_chars_result r = std::from_chars(p, to, weight);
+    if (r.ec != std::errc())
+      Fail("Malformed weight", p);
+    // from_chars also takes nan and inf, which no comparison in Prim's
+    // would ever pick
+    if (!std::isfinite(weight) || weight < 0) {
+      std::ostringstream ss;
+      ss << "Invalid weight " << weight;
+      Fail(ss.str(), p);
+    }
+    // -0.0 sorts below every weight as a bit pattern; store +0.0
+    if (weight == 0)
+      weight = 0;
+
+    // nothing but blanks may follow on the line
+    p = SkipBlanks(r.ptr, to);
+    if (p != to && *p != '\n')
+      Fail("Unexpected characters after weight", p);
+    fn(Edge(source, destination, weight));
+    p = SkipSpace(p, to);
+  }
+}
+
+inline void EWDReader::ParseEdges(std::vector<Edge> &edges,
+                                  unsigned int num_threads) const {
+  if (num_threads <= 1) {
+    edges.reserve(edges.size() + std::count(body, end, '\n') + 1);
+    ParseEdges(body, end, edges);
+    return;
+  }
+
+  // 1. Move every even split point forward to the start of a line
+  std::vector<const char *> bounds(num_threads + 1, end);
+  bounds[0] = body;
+  for (unsigned int t = 1; t < num_threads; t++) {
+    const char *p = body + ChunkBegin(end - body, t, num_threads);
+    p = std::find(std::max(p, bounds[t - 1]), end, '\n');
+    bounds[t] = (p == end) ? end : p + 1;
+  }
+
+  // 2. Parse the chunks into thread-local buffers
+  std::vector<std::vector<Edge>> parts(num_threads);
+  ParallelFor(num_threads, [&](unsigned int t) {
+    parts[t].reserve(std::count(bounds[t], bounds[t + 1], '\n') + 1);
+    ParseEdges(bounds[t], bounds[t + 1], parts[t]);
+  });
+
+  // 3. Concatenate the buffers in file order
+  std::vector<size_t> at(num_threads + 1, edges.size());
+  for (unsigned int t = 0; t < num_threads; t++)
+    at[t + 1] = at[t] + parts[t].size();
+  edges.resize(at[num_threads]);
+  ParallelFor(num_threads, [&](unsigned int t) {
+    std::copy(parts[t].begin(), parts[t].end(), edges.begin() + at[t]);
+    std::vector<Edge>().swap(parts[t]);
+  });
+}
+
+#endif  // EWD_READER_H_
@@ -0,0 +1,125 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef FOREST_MST_H_
+#define FOREST_MST_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "graph.h"
+#include "index_min_pq.h"
+#include "mst.h"
+#include "mst_result.h"
+#include "parallel.h"
+#include "prim_key.h"
+#include "union_find.h"
+
+// FOREST MIN SPANNING TREE CLASS
+// Minimum spanning forest with one Prim's task per connected component.
+// A parallel union-find pass finds the components first. Components then
+// go to the threads largest first, each thread taking the next one as it
+// finishes, and every tree grows from its lowest vertex exactly as MST
+// grows it, so the forest is identical to MST's.
+template <typename PQ = IndexMinPQ<PrimKey>>
+class ForestMST {
+ public:
+  // computes the minimum spanning forest of @graph on @num_threads threads
+  explicit ForestMST(const Graph &graph, unsigned int num_threads = 1);
+  // return the computed forest; its Component* members give the trees
+  const MSTResult &Result() const {
+    return result;
+  }
+  // return the edge that connects each vertex to the tree
+  const std::vector<Edge> &Edges() const {
+    return result.Edges();
+  }
+  // print out the tree edges and total weight
+  void Print(OutputMode mode = OutputMode::kFull) const {
+    PrintMST(result, mode);
+  }
+
+ private:
+  MSTResult result;
+};
+
+template <typename PQ>
+ForestMST<PQ>::ForestMST(const Graph &graph, unsigned int num_threads) {
+  const size_t n = graph.NumVertices();
+  const EdgeSpan edges = graph.Edges();
+
+  // 1. Components: linking always keeps the smaller root, so every root
+  // is the lowest vertex of its component
+  ConcurrentUnionFind components(n);
+  ParallelFor(num_threads, [&](unsigned int t) {
+    size_t end = ChunkBegin(edges.size(), t + 1, num_threads);
+    for (size_t e = ChunkBegin(edges.size(), t, num_threads); e < end; e++)
+      components.Union(edges[e].Source(), edges[e].Destination());
+  });
+  // every vertex gets a slot, its rank in its component, and members
+  // lists the vertices of each component from start[root] on, in order
+  std::vector<unsigned int> root(n), slot(n), members(n);
+  std::vector<size_t> size(n, 0), start(n + 1, 0);
+  for (unsigned int v = 0; v < n; v++) {
+    root[v] = components.Find(v);
+    slot[v] = size[root[v]]++;
+  }
+  for (unsigned int v = 0; v < n; v++)
+    start[v + 1] = start[v] + size[v];
+  for (unsigned int v = 0; v < n; v++)
+    members[start[root[v]] + slot[v]] = v;
+
+  // 2. One task per component with an edge, largest first so that the
+  // long tasks do not start last
+  std::vector<unsigned int> roots;
+  for (unsigned int v = 0; v < n; v++) {
+    if (size[v] > 1)
+      roots.push_back(v);
+  }
+  std::stable_sort(roots.begin(), roots.end(),
+                   [&size](unsigned int a, unsigned int b) {
+                     return size[a] > size[b];
+                   });
+
+  // 3. Queue and distances are indexed by slot, so a thread's scratch is
+  // sized to the first (largest) component it takes and reset over that
+  // component only; trees touch disjoint vertices, so all write the same
+  // edge array
+  std::vector<Edge> edge(n, Edge(0, 0, 0));
+  unsigned int workers = std::max<size_t>(
+      1, std::min<size_t>(num_threads, roots.size()));
+  struct Scratch {
+    explicit Scratch(size_t n)
+      : pqueue(n), dist(n, PrimKey::Infinity()), marked(n, false) {}
+    PQ pqueue;
+    std::vector<PrimKey> dist;
+    std::vector<bool> marked;
+  };
+  // slots of one component
+  struct ComponentSlots {
+    const unsigned int *slot;
+    const unsigned int *members;  // of this component
+    unsigned int Slot(unsigned int v) const {
+      return slot[v];
+    }
+    unsigned int Vertex(unsigned int s) const {
+      return members[s];
+    }
+  };
+  std::vector<std::unique_ptr<Scratch>> scratch(workers);
+  ParallelForEach(workers, roots.size(), [&](unsigned int t, size_t i) {
+    const unsigned int r = roots[i];
+    if (!scratch[t] || scratch[t]->dist.size() < size[r])
+      scratch[t].reset(new Scratch(size[r]));
+    Scratch &s = *scratch[t];
+    GrowPrimTree(graph, r, s.pqueue, s.dist, s.marked, edge,
+                 [](const Arc &) { return true; },
+                 ComponentSlots{slot.data(), members.data() + start[r]});
+    std::fill(s.dist.begin(), s.dist.begin() + size[r],
+              PrimKey::Infinity());
+    std::fill(s.marked.begin(), s.marked.begin() + size[r], false);
+  });
+  result = MSTResult(std::move(edge));
+}
+
+#endif  // FOREST_MST_H_
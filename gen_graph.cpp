@@ -0,0 +1,261 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "graph_file.h"
+#include "graph_generator.h"
+
+// Prints how to call the program
+static int Usage(const char *program) {
+  std::cerr << "Usage " << program << " [options] <type> <out>\n"
+            << "Writes a reproducible synthetic graph to <out> (- for\n"
+            << "stdout, text only). Types:\n"
+            << "  geometric    random points in the unit square linked to\n"
+            << "               nearby points, weighted by distance\n"
+            << "  er           random spanning path plus random edges\n"
+            << "  grid         side x side lattice, random weights\n"
+            << "  powerlaw     spanning path plus edges favoring low ids\n"
+            << "  components   disjoint er graphs, vertices interleaved\n"
+            << "Options:\n"
+            << "  --vertices N number of vertices (a square for grid)\n"
+            << "  --edges M    number of edges (not for grid)\n"
+            << "  --seed S     random seed (default 1)\n"
+            << "  --components K\n"
+            << "               components of a components graph (16)\n"
+            << "  --skew X     powerlaw endpoint skew, at least 1 (3)\n"
+            << "  --format F   ewd (default) text, or bin for the binary\n"
+            << "               graph file prim_mst loads directly\n"
+            << "  --memory MB  memory for the binary adjacency arrays\n"
+            << "               (default 1024); bigger graphs take one\n"
+            << "               extra pass per MB-sized block of vertices"
+            << std::endl;
+  return 1;
+}
+
+// Streams the graph of @gen as EWD text to @fd, one buffer at a time
+static void WriteEWD(const GraphGenerator &gen, int fd) {
+  const size_t kFlushAt = 1 << 20;
+  std::string buffer;
+  buffer.reserve(kFlushAt + 64);
+  auto flush = [&]() {
+    for (size_t done = 0; done < buffer.size();) {
+      ssize_t written = write(fd, buffer.data() + done, buffer.size() - done);
+      if (written < 0 && errno == EINTR)
+        continue;
+      if (written <= 0)
+        throw std::runtime_error("Error: cannot write output");
+      done += written;
+    }
+    buffer.clear();
+  };
+
+  buffer = std::to_string(gen.NumVertices()) + "\n";
+  gen.ForEachEdge([&](uint64_t u, uint64_t v, double w) {
+    char line[64];
+    char *p = std::to_chars(line, line + 20, u).ptr;
+    *p++ = ' ';
+    p = std::to_chars(p, p + 20, v).ptr;
+    *p++ = ' ';
+    p = std::to_chars(p, line + sizeof(line) - 1, w, std::chars_format::fixed,
+                      5).ptr;
+    *p++ = '\n';
+    buffer.append(line, p);
+    if (buffer.size() >= kFlushAt)
+      flush();
+  });
+  flush();
+}
+
+// Streams the graph of @gen to @fd in the binary graph file format. The
+// edge records go out on a first pass that also counts degrees; then
+// every block of vertices whose adjacency entries fit in
+// @memory_bytes takes one more pass over the edges, scattering that
+// block's entries. Only the degrees (4 bytes per vertex) and one block
+// stay in memory. The checksum is computed by reading the file back.
+static void WriteBinary(const GraphGenerator &gen, int fd,
+                        size_t memory_bytes) {
+  const uint64_t n = gen.NumVertices(), m = gen.NumEdges();
+  GraphFileSections sections(n, m);
+  const off_t edges_at = sizeof(GraphFileHeader);
+  const off_t offsets_at = edges_at + sections.edges;
+  const off_t neighbors_at = offsets_at + sections.offsets;
+  const off_t weights_at = neighbors_at + sections.neighbors;
+  const off_t ids_at = weights_at + sections.weights;
+  if (ftruncate(fd, sizeof(GraphFileHeader) + sections.Total()) < 0)
+    throw std::runtime_error("Error: cannot write output");
+
+  // 1. Edge records and degrees
+  std::vector<uint32_t> degree(n, 0);
+  std::vector<Edge> records;
+  records.reserve(1 << 16);
+  off_t at = edges_at;
+  auto flush_records = [&]() {
+    WriteGraphFileAt(fd, records.data(), records.size() * sizeof(Edge), at);
+    at += records.size() * sizeof(Edge);
+    records.clear();
+  };
+  gen.ForEachEdge([&](uint64_t u, uint64_t v, double w) {
+    records.push_back(Edge(u, v, w));
+    degree[u]++;
+    degree[v]++;
+    if (records.size() == records.capacity())
+      flush_records();
+  });
+  flush_records();
+
+  // 2. Offsets, the running sum of the degrees
+  std::vector<uint64_t> offsets;
+  offsets.reserve(1 << 16);
+  uint64_t total = 0;
+  at = offsets_at;
+  for (uint64_t v = 0; v <= n; v++) {
+    offsets.push_back(total);
+    if (v < n)
+      total += degree[v];
+    if (offsets.size() == offsets.capacity() || v == n) {
+      WriteGraphFileAt(fd, offsets.data(),
+                       offsets.size() * sizeof(uint64_t), at);
+      at += offsets.size() * sizeof(uint64_t);
+      offsets.clear();
+    }
+  }
+
+  // 3. Adjacency entries, block by block of vertices
+  const size_t entry_bytes = 2 * sizeof(uint32_t) + sizeof(double);
+  const uint64_t budget = std::max<size_t>(1, memory_bytes / entry_bytes);
+  std::vector<uint32_t> neighbors, ids;
+  std::vector<double> weights;
+  uint64_t first_entry = 0;
+  for (uint64_t begin = 0; begin < n;) {
+    // the vertices [begin, end) and their entries from first_entry on
+    uint64_t end = begin, count = 0;
+    do {
+      count += degree[end++];
+    } while (end < n && count + degree[end] <= budget);
+    std::vector<uint64_t> cursor(end - begin);
+    for (uint64_t v = begin, next = 0; v < end; v++) {
+      cursor[v - begin] = next;
+      next += degree[v];
+    }
+    neighbors.resize(count);
+    weights.resize(count);
+    ids.resize(count);
+
+    // same order as a Graph built from the edge list: by edge id
+    uint64_t id = 0;
+    gen.ForEachEdge([&](uint64_t u, uint64_t v, double w) {
+      if (u >= begin && u < end) {
+        uint64_t i = cursor[u - begin]++;
+        neighbors[i] = v;
+        weights[i] = w;
+        ids[i] = id;
+      }
+      if (v >= begin && v < end) {
+        uint64_t i = cursor[v - begin]++;
+        neighbors[i] = u;
+        weights[i] = w;
+        ids[i] = id;
+      }
+      id++;
+    });
+    WriteGraphFileAt(fd, neighbors.data(), count * sizeof(uint32_t),
+                     neighbors_at + first_entry * sizeof(uint32_t));
+    WriteGraphFileAt(fd, weights.data(), count * sizeof(double),
+                     weights_at + first_entry * sizeof(double));
+    WriteGraphFileAt(fd, ids.data(), count * sizeof(uint32_t),
+                     ids_at + first_entry * sizeof(uint32_t));
+    first_entry += count;
+    begin = end;
+  }
+
+  // 4. Header, with the checksum of the payload as written
+  GraphFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kGraphFileMagic, sizeof(header.magic));
+  header.version = GraphFileHeader::kVersion;
+  header.weight_bytes = sizeof(double);
+  header.num_vertices = n;
+  header.num_edges = m;
+  header.payload_bytes = sections.Total();
+  size_t mapped = sizeof(header) + sections.Total();
+  void *file = mmap(nullptr, mapped, PROT_READ, MAP_SHARED, fd, 0);
+  if (file == MAP_FAILED)
+    throw std::runtime_error("Error: cannot read output back");
+  header.checksum = GraphFileChecksum(static_cast<char *>(file) +
+                                      sizeof(header), sections.Total());
+  munmap(file, mapped);
+  WriteGraphFileAt(fd, &header, sizeof(header), 0);
+}
+
+// MAIN FUNCTION
+int main(int argc, char *argv[]) {
+  GeneratorOptions options;
+  std::string format = "ewd";
+  size_t memory_mb = 1024;
+  std::vector<const char *> args;
+  for (int i = 1; i < argc; i++) {
+    if (!std::strcmp(argv[i], "--vertices") && i + 1 < argc) {
+      options.num_vertices = std::strtoull(argv[++i], nullptr, 10);
+    } else if (!std::strcmp(argv[i], "--edges") && i + 1 < argc) {
+      options.num_edges = std::strtoull(argv[++i], nullptr, 10);
+    } else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) {
+      options.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (!std::strcmp(argv[i], "--components") && i + 1 < argc) {
+      options.components = std::strtoull(argv[++i], nullptr, 10);
+    } else if (!std::strcmp(argv[i], "--skew") && i + 1 < argc) {
+      options.skew = std::strtod(argv[++i], nullptr);
+    } else if (!std::strcmp(argv[i], "--format") && i + 1 < argc) {
+      format = argv[++i];
+      if (format != "ewd" && format != "bin")
+        return Usage(argv[0]);
+    } else if (!std::strcmp(argv[i], "--memory") && i + 1 < argc) {
+      memory_mb = std::strtoull(argv[++i], nullptr, 10);
+      if (memory_mb == 0)
+        return Usage(argv[0]);
+    } else {
+      args.push_back(argv[i]);
+    }
+  }
+  if (args.size() != 2)
+    return Usage(argv[0]);
+  options.type = args[0];
+  bool to_stdout = !std::strcmp(args[1], "-");
+  if (to_stdout && format == "bin")
+    return Usage(argv[0]);
+
+  try {
+    GraphGenerator gen(options);
+    int fd = STDOUT_FILENO;
+    if (!to_stdout) {
+      fd = open(args[1], format == "bin" ? O_RDWR | O_CREAT | O_TRUNC
+                                         : O_WRONLY | O_CREAT | O_TRUNC,
+                0644);
+      if (fd < 0)
+        throw std::runtime_error(std::string("Error: cannot open file ") +
+                                 args[1]);
+    }
+    if (format == "bin")
+      WriteBinary(gen, fd, memory_mb << 20);
+    else
+      WriteEWD(gen, fd);
+    if (!to_stdout && close(fd) < 0)
+      throw std::runtime_error("Error: cannot write output");
+  } catch (const std::runtime_error &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
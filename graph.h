@@ -0,0 +1,364 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef GRAPH_H_
+#define GRAPH_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "parallel.h"
+
+// EDGE CLASS
+class Edge {
+ public:
+  Edge() : source(0), destination(0), weight(0) {}
+  // initializes private variables
+  Edge(unsigned int s, unsigned int d, double w)
+    : source(s), destination(d), weight(w) {}
+  // return source
+  unsigned int Source() const {
+    return source;
+  }
+  // return destination
+  unsigned int Destination() const {
+    return destination;
+  }
+  // return weight
+  double Weight() const {
+    return weight;
+  }
+
+ private:
+  unsigned int source, destination;
+  double weight;
+};
+
+// EDGE SPAN CLASS
+// Non-owning, read-only view of a contiguous array of edges
+class EdgeSpan {
+ public:
+  EdgeSpan() : first(nullptr), count(0) {}
+  EdgeSpan(const Edge *data, size_t size) : first(data), count(size) {}
+  // views all of @edges
+  EdgeSpan(const std::vector<Edge> &edges)  // NOLINT(runtime/explicit)
+    : first(edges.data()), count(edges.size()) {}
+  const Edge *data() const {
+    return first;
+  }
+  size_t size() const {
+    return count;
+  }
+  bool empty() const {
+    return count == 0;
+  }
+  const Edge &operator[](size_t i) const {
+    return first[i];
+  }
+  const Edge *begin() const {
+    return first;
+  }
+  const Edge *end() const {
+    return first + count;
+  }
+
+ private:
+  const Edge *first;
+  size_t count;
+};
+
+// ARC STRUCT
+// One adjacency entry as seen from its owning vertex
+struct Arc {
+  unsigned int vertex;  // the other endpoint
+  double weight;
+  size_t position;      // position in the CSR arrays
+};
+
+class Graph;
+class MappedFile;
+
+// ARC RANGE CLASS
+// Non-owning, read-only view of the adjacency entries of one vertex;
+// iterating it reads straight from the graph's arrays without copying.
+class ArcRange {
+ public:
+  class Iterator {
+   public:
+    Iterator(const Graph *g, size_t i) : graph(g), pos(i) {}
+    Arc operator*() const;
+    Iterator &operator++() {
+      pos++;
+      return *this;
+    }
+    bool operator!=(const Iterator &other) const {
+      return pos != other.pos;
+    }
+
+   private:
+    const Graph *graph;
+    size_t pos;
+  };
+
+  ArcRange(const Graph *g, size_t b, size_t e) : graph(g), first(b), last(e) {}
+  Iterator begin() const {
+    return Iterator(graph, first);
+  }
+  Iterator end() const {
+    return Iterator(graph, last);
+  }
+  // return number of entries in the range
+  size_t size() const {
+    return last - first;
+  }
+
+ private:
+  const Graph *graph;
+  size_t first, last;
+};
+
+// GRAPH CLASS
+// Immutable undirected graph in compressed sparse row (CSR) form: the
+// adjacency entries of vertex u are stored contiguously at positions
+// [Begin(u), End(u)) of the parallel neighbor/weight/edge id arrays.
+// Their sizes are known from the degree count before anything is
+// written, so the offsets and the three arrays share one exactly sized
+// allocation, freed at once with the graph. A graph read from a binary
+// graph file instead views the arrays in the file's mapping, which it
+// keeps alive. Graphs move but do not copy.
+class Graph {
+ public:
+  // builds the CSR arrays from an edge list (taken over, not copied);
+  // every edge is listed under both of its endpoints, in input order.
+  // The counting and scatter passes are split across @num_threads
+  // threads, at most one per unit of average degree; the result does not
+  // depend on the thread count.
+  Graph(size_t num_vertices, std::vector<Edge> edge_list,
+        unsigned int num_threads = 1);
+  // return number of vertices
+  size_t NumVertices() const {
+    return num_vertices;
+  }
+  // return number of (undirected) edges
+  size_t GetNumEdges() const {
+    return num_edges;
+  }
+  // return position of the first adjacency entry of vertex u
+  size_t Begin(unsigned int u) const {
+    return offsets[u];
+  }
+  // return position one past the last adjacency entry of vertex u
+  size_t End(unsigned int u) const {
+    return offsets[u + 1];
+  }
+  // return a read-only view of the adjacency entries of vertex u
+  ArcRange Arcs(unsigned int u) const {
+    return ArcRange(this, offsets[u], offsets[u + 1]);
+  }
+  // calls @fn(arc) for every adjacency entry of vertex u, as Arcs(u) would
+  // give them
+  template <typename Fn>
+  void ForEachArc(unsigned int u, Fn fn) const {
+    for (size_t i = offsets[u]; i < offsets[u + 1]; i++)
+      fn(Arc{neighbors[i], weights[i], i});
+  }
+  // return the input edge adjacency entry @arc of vertex u was built from
+  const Edge &ArcEdge(unsigned int, const Arc &arc) const {
+    return GetEdge(arc.position);
+  }
+  // return the id (position in Edges()) of the edge adjacency entry @arc
+  // of vertex u was built from
+  unsigned int ArcId(unsigned int, const Arc &arc) const {
+    return edge_ids[arc.position];
+  }
+  // return the input edges
+  EdgeSpan Edges() const {
+    return EdgeSpan(edges, num_edges);
+  }
+  // return the vertex at the other end of adjacency entry i
+  unsigned int Neighbor(size_t i) const {
+    return neighbors[i];
+  }
+  // return the weight of adjacency entry i
+  double Weight(size_t i) const {
+    return weights[i];
+  }
+  // return the input edge adjacency entry i was built from
+  const Edge &GetEdge(size_t i) const {
+    return edges[edge_ids[i]];
+  }
+  // return the id (position in Edges()) of the edge adjacency entry i was
+  // built from
+  unsigned int EdgeId(size_t i) const {
+    return edge_ids[i];
+  }
+
+ private:
+  // the binary graph file stores and restores the arrays as they are
+  friend void WriteGraphFile(const Graph &graph, const char *path);
+  friend Graph ReadGraphFile(std::shared_ptr<const MappedFile> file,
+                             bool verify_checksum);
+  Graph() {}
+  // Writable pointers to the arrays while they are built
+  struct Arrays {
+    size_t *offsets;
+    double *weights;
+    unsigned int *neighbors;
+    unsigned int *edge_ids;
+  };
+  // Carves the arrays for @n vertices and @entries adjacency entries out
+  // of one new block; the offsets start zeroed, the rest uninitialized
+  Arrays Allocate(size_t n, size_t entries);
+
+  std::vector<Edge> owned_edges;        // input edges, unless viewed
+  std::unique_ptr<char[]> arena;        // the arrays, unless viewed
+  std::shared_ptr<const void> mapping;  // keeps viewed arrays alive
+  const Edge *edges = nullptr;          // input edges, as oriented in input
+  size_t num_edges = 0;
+  size_t num_vertices = 0;
+  const size_t *offsets = nullptr;      // size num_vertices + 1
+  const double *weights = nullptr;      // size 2 * num_edges
+  const unsigned int *neighbors = nullptr;  // size 2 * num_edges
+  const unsigned int *edge_ids = nullptr;   // size 2 * num_edges
+};
+
+inline Graph::Arrays Graph::Allocate(size_t n, size_t entries) {
+  // widest elements first, so every array is aligned
+  const size_t bytes = (n + 1) * sizeof(size_t) + entries * sizeof(double) +
+      2 * entries * sizeof(unsigned int);
+  arena.reset(new char[bytes]);
+  num_vertices = n;
+  Arrays out;
+  out.offsets = reinterpret_cast<size_t *>(arena.get());
+  out.weights = reinterpret_cast<double *>(out.offsets + n + 1);
+  out.neighbors = reinterpret_cast<unsigned int *>(out.weights + entries);
+  out.edge_ids = out.neighbors + entries;
+  std::fill(out.offsets, out.offsets + n + 1, 0);
+  offsets = out.offsets;
+  weights = out.weights;
+  neighbors = out.neighbors;
+  edge_ids = out.edge_ids;
+  return out;
+}
+
+inline Arc ArcRange::Iterator::operator*() const {
+  return Arc{graph->Neighbor(pos), graph->Weight(pos), pos};
+}
+
+inline Graph::Graph(size_t num_vertices, std::vector<Edge> edge_list,
+                    unsigned int num_threads)
+  : owned_edges(std::move(edge_list)) {
+  edges = owned_edges.data();
+  num_edges = owned_edges.size();
+  Arrays out = Allocate(num_vertices, 2 * num_edges);
+  // Thread t owns the edges [ChunkBegin(t), ChunkBegin(t + 1)) and, for
+  // the prefix pass, the vertices in the same share of [0, num_vertices).
+  // Each thread keeps a count per vertex, so the threads are capped at
+  // the average degree: the counts then take at most 16 bytes per edge,
+  // a third of the graph itself, however many threads are asked for.
+  const size_t average_degree = 2 * num_edges / std::max<size_t>(
+      1, num_vertices);
+  const unsigned int threads = std::max<size_t>(
+      1, std::min<size_t>(num_threads, average_degree));
+  std::vector<std::vector<size_t>> next(threads);
+
+  // 1. Every thread counts the degrees its own edges contribute
+  ParallelFor(threads, [&](unsigned int t) {
+    std::vector<size_t> &count = next[t];
+    count.assign(num_vertices, 0);
+    size_t last = ChunkBegin(num_edges, t + 1, threads);
+    for (size_t id = ChunkBegin(num_edges, t, threads); id < last; id++) {
+      count[edges[id].Source()]++;
+      count[edges[id].Destination()]++;
+    }
+  });
+
+  // 2. Prefix sum over vertices turns degrees into starting positions;
+  // each vertex's block is split between the threads in edge order, so
+  // thread t's counts become the positions its entries are written to
+  std::vector<size_t> share(threads + 1, 0);
+  ParallelFor(threads, [&](unsigned int t) {
+    size_t last = ChunkBegin(num_vertices, t + 1, threads);
+    for (size_t v = ChunkBegin(num_vertices, t, threads); v < last; v++) {
+      for (unsigned int k = 0; k < threads; k++)
+        out.offsets[v + 1] += next[k][v];
+      share[t + 1] += out.offsets[v + 1];
+    }
+  });
+  for (unsigned int t = 0; t < threads; t++)
+    share[t + 1] += share[t];
+  ParallelFor(threads, [&](unsigned int t) {
+    size_t position = share[t];
+    size_t last = ChunkBegin(num_vertices, t + 1, threads);
+    for (size_t v = ChunkBegin(num_vertices, t, threads); v < last; v++) {
+      out.offsets[v] = position;
+      for (unsigned int k = 0; k < threads; k++) {
+        size_t count = next[k][v];
+        next[k][v] = position;
+        position += count;
+      }
+    }
+  });
+  out.offsets[num_vertices] = 2 * num_edges;
+
+  // 3. Scatter each edge under both endpoints, preserving input order
+  ParallelFor(threads, [&](unsigned int t) {
+    std::vector<size_t> &cursor = next[t];
+    size_t last = ChunkBegin(num_edges, t + 1, threads);
+    for (size_t id = ChunkBegin(num_edges, t, threads); id < last; id++) {
+      const Edge &e = edges[id];
+      size_t i = cursor[e.Source()]++;
+      out.neighbors[i] = e.Destination();
+      out.weights[i] = e.Weight();
+      out.edge_ids[i] = id;
+      size_t j = cursor[e.Destination()]++;
+      out.neighbors[j] = e.Source();
+      out.weights[j] = e.Weight();
+      out.edge_ids[j] = id;
+    }
+  });
+}
+
+// Removes parallel edges from @edges in place. (u, v) and (v, u) are the
+// same undirected edge: only the lightest copy survives, in the position
+// of the first copy read (ties keep the first). Self-loops can never be
+// part of a spanning tree and are dropped. Runs in expected linear time
+// with an open-addressing table of packed (min, max) endpoint keys.
+inline void DedupEdges(std::vector<Edge> &edges) {
+  // Table of at least twice as many slots as edges, a power of two
+  unsigned int bits = 1;
+  while ((size_t(1) << bits) < 2 * edges.size())
+    bits++;
+  const size_t mask = (size_t(1) << bits) - 1;
+  const uint64_t empty = ~uint64_t(0);  // min < max, so never a real key
+  std::vector<uint64_t> keys(mask + 1, empty);
+  std::vector<size_t> kept_at(mask + 1);
+
+  size_t kept = 0;
+  for (size_t i = 0; i < edges.size(); i++) {
+    const Edge e = edges[i];
+    unsigned int lo = std::min(e.Source(), e.Destination());
+    unsigned int hi = std::max(e.Source(), e.Destination());
+    if (lo == hi)
+      continue;
+
+    // Fibonacci hashing on the high bits, then linear probing
+    uint64_t key = (uint64_t(lo) << 32) | hi;
+    size_t slot = (key * 0x9E3779B97F4A7C15ULL) >> (64 - bits);
+    while (keys[slot] != empty && keys[slot] != key)
+      slot = (slot + 1) & mask;
+
+    if (keys[slot] == empty) {
+      keys[slot] = key;
+      kept_at[slot] = kept;
+      edges[kept++] = e;
+    } else if (e.Weight() < edges[kept_at[slot]].Weight()) {
+      edges[kept_at[slot]] = e;
+    }
+  }
+  edges.erase(edges.begin() + kept, edges.end());
+}
+
+#endif  // GRAPH_H_
@@ -0,0 +1,251 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef GRAPH_FILE_H_
+#define GRAPH_FILE_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "graph.h"
+#include "mapped_file.h"
+
+// Binary graph file layout (native byte order), version 1:
+//
+//   GraphFileHeader                       64 bytes
+//   edges      num_edges      x Edge      (uint32 source, destination,
+//                                          double weight; 16 bytes)
+//   offsets    num_vertices+1 x uint64
+//   neighbors  2 * num_edges  x uint32
+//   weights    2 * num_edges  x double
+//   edge_ids   2 * num_edges  x uint32
+//
+// Every array starts on a 64-byte boundary, so the payload is used
+// straight from a memory mapping. The checksum covers the whole payload.
+// Readers check it by default: the range checks read most of the file
+// anyway, and a flipped bit must not load as a different graph.
+
+// Return true if [begin, end) starts with the binary graph magic number
+bool IsGraphFile(const char *begin, const char *end);
+// Writes @graph to @path in the binary format, one section at a time
+void WriteGraphFile(const Graph &graph, const char *path);
+// Return the graph in the binary file mapped by @file, viewing its arrays
+// in place: the graph keeps the mapping alive and copies nothing. The
+// counts, offsets, vertex numbers, edge ids and edge weights are checked,
+// so that a bad file cannot make the graph read out of bounds, and every
+// adjacency entry must name its own edge's other endpoint and weight; the
+// payload checksum too unless @verify_checksum is false. Throws
+// std::runtime_error on a bad magic number, unknown version, truncation
+// or failed check.
+Graph ReadGraphFile(std::shared_ptr<const MappedFile> file,
+                    bool verify_checksum = true);
+
+// GRAPH FILE HEADER STRUCT
+struct GraphFileHeader {
+  static constexpr size_t kAlignment = 64;
+  static constexpr uint32_t kVersion = 1;
+
+  char magic[8];          // "P5GRAPH\n"
+  uint32_t version;
+  uint32_t weight_bytes;  // sizeof(double)
+  uint64_t num_vertices;
+  uint64_t num_edges;
+  uint64_t payload_bytes;
+  uint64_t checksum;
+  char reserved[16];
+};
+static_assert(sizeof(GraphFileHeader) == GraphFileHeader::kAlignment,
+              "graph file header must fill one aligned block");
+static_assert(sizeof(Edge) == 16, "edges are stored as 16-byte records");
+
+static const char kGraphFileMagic[8] = {'P', '5', 'G', 'R', 'A', 'P', 'H',
+                                        '\n'};
+
+// Return @bytes rounded up to the next multiple of the alignment
+inline size_t AlignGraphFile(size_t bytes) {
+  const size_t a = GraphFileHeader::kAlignment;
+  return (bytes + a - 1) / a * a;
+}
+
+static_assert(sizeof(size_t) == sizeof(uint64_t),
+              "offsets are viewed in place as size_t");
+
+// Word-at-a-time FNV-1a style hash of @bytes (a multiple of 8) bytes; a
+// hash of consecutive pieces passes each piece the @hash of those before
+inline uint64_t GraphFileChecksum(const char *data, size_t bytes,
+                                  uint64_t hash = 0xcbf29ce484222325ULL) {
+  for (size_t i = 0; i < bytes; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, data + i, 8);
+    hash = (hash ^ word) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+inline bool IsGraphFile(const char *begin, const char *end) {
+  return static_cast<size_t>(end - begin) >= sizeof(kGraphFileMagic) &&
+         !std::memcmp(begin, kGraphFileMagic, sizeof(kGraphFileMagic));
+}
+
+// Section sizes of a graph, in bytes, each padded to the alignment
+struct GraphFileSections {
+  GraphFileSections(uint64_t num_vertices, uint64_t num_edges)
+    : edges(AlignGraphFile(num_edges * sizeof(Edge))),
+      offsets(AlignGraphFile((num_vertices + 1) * sizeof(uint64_t))),
+      neighbors(AlignGraphFile(2 * num_edges * sizeof(uint32_t))),
+      weights(AlignGraphFile(2 * num_edges * sizeof(double))),
+      edge_ids(AlignGraphFile(2 * num_edges * sizeof(uint32_t))) {}
+  size_t Total() const {
+    return edges + offsets + neighbors + weights + edge_ids;
+  }
+  size_t edges, offsets, neighbors, weights, edge_ids;
+};
+
+// Writes all @bytes bytes at @data to @fd at @offset
+inline void WriteGraphFileAt(int fd, const void *data, size_t bytes,
+                             off_t offset) {
+  const char *p = static_cast<const char *>(data);
+  while (bytes > 0) {
+    ssize_t written = pwrite(fd, p, bytes, offset);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written <= 0)
+      throw std::runtime_error("Error: cannot write output");
+    p += written;
+    bytes -= written;
+    offset += written;
+  }
+}
+
+inline void WriteGraphFile(const Graph &graph, const char *path) {
+  const uint64_t v = graph.NumVertices(), e = graph.GetNumEdges();
+  GraphFileSections sections(v, e);
+  int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    throw std::runtime_error(std::string("Error: cannot write file ") + path);
+
+  // every section straight from the graph, then its zero padding; the
+  // header goes in front once the checksum is known
+  uint64_t checksum = GraphFileChecksum(nullptr, 0);
+  off_t at = sizeof(GraphFileHeader);
+  const char zeros[GraphFileHeader::kAlignment] = {};
+  auto section = [&](const void *data, size_t bytes, size_t padded) {
+    checksum = GraphFileChecksum(static_cast<const char *>(data), bytes,
+                                 checksum);
+    checksum = GraphFileChecksum(zeros, padded - bytes, checksum);
+    WriteGraphFileAt(fd, data, bytes, at);
+    WriteGraphFileAt(fd, zeros, padded - bytes, at + bytes);
+    at += padded;
+  };
+  try {
+    section(graph.edges, e * sizeof(Edge), sections.edges);
+    section(graph.offsets, (v + 1) * sizeof(uint64_t), sections.offsets);
+    section(graph.neighbors, 2 * e * sizeof(uint32_t), sections.neighbors);
+    section(graph.weights, 2 * e * sizeof(double), sections.weights);
+    section(graph.edge_ids, 2 * e * sizeof(uint32_t), sections.edge_ids);
+
+    GraphFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kGraphFileMagic, sizeof(header.magic));
+    header.version = GraphFileHeader::kVersion;
+    header.weight_bytes = sizeof(double);
+    header.num_vertices = v;
+    header.num_edges = e;
+    header.payload_bytes = sections.Total();
+    header.checksum = checksum;
+    WriteGraphFileAt(fd, &header, sizeof(header), 0);
+  } catch (const std::runtime_error &) {
+    close(fd);
+    throw std::runtime_error(std::string("Error: cannot write file ") + path);
+  }
+  if (close(fd) < 0)
+    throw std::runtime_error(std::string("Error: cannot write file ") + path);
+}
+
+inline Graph ReadGraphFile(std::shared_ptr<const MappedFile> file,
+                           bool verify_checksum) {
+  const char *begin = file->Begin(), *end = file->End();
+  const size_t size = end - begin;
+  if (!IsGraphFile(begin, end) || size < sizeof(GraphFileHeader))
+    throw std::runtime_error("Error: not a graph file");
+  GraphFileHeader header;
+  std::memcpy(&header, begin, sizeof(header));
+  if (header.version != GraphFileHeader::kVersion ||
+      header.weight_bytes != sizeof(double))
+    throw std::runtime_error("Error: unsupported graph file version " +
+                             std::to_string(header.version));
+
+  const uint64_t v = header.num_vertices, e = header.num_edges;
+  if (v > ~0U || e > ~0U)
+    throw std::runtime_error("Error: corrupt graph file (bad counts)");
+  GraphFileSections sections(v, e);
+  if (header.payload_bytes != sections.Total() ||
+      size - sizeof(header) < sections.Total())
+    throw std::runtime_error("Error: truncated graph file");
+  const char *payload = begin + sizeof(header);
+  if (verify_checksum &&
+      GraphFileChecksum(payload, sections.Total()) != header.checksum)
+    throw std::runtime_error("Error: corrupt graph file (checksum mismatch)");
+
+  // Point the graph at the sections
+  Graph graph;
+  const char *p = payload;
+  graph.edges = reinterpret_cast<const Edge *>(p);
+  p += sections.edges;
+  graph.offsets = reinterpret_cast<const size_t *>(p);
+  p += sections.offsets;
+  graph.neighbors = reinterpret_cast<const unsigned int *>(p);
+  p += sections.neighbors;
+  graph.weights = reinterpret_cast<const double *>(p);
+  p += sections.weights;
+  graph.edge_ids = reinterpret_cast<const unsigned int *>(p);
+  graph.num_vertices = v;
+  graph.num_edges = e;
+
+  // Everything an index is taken from must be in range
+  auto corrupt = [](const char *what) {
+    throw std::runtime_error(std::string("Error: corrupt graph file (") +
+                             what + ")");
+  };
+  if (graph.offsets[0] != 0 || graph.offsets[v] != 2 * e)
+    corrupt("bad offsets");
+  for (size_t u = 0; u < v; u++) {
+    if (graph.offsets[u] > graph.offsets[u + 1])
+      corrupt("bad offsets");
+  }
+  for (size_t id = 0; id < e; id++) {
+    const Edge &edge = graph.edges[id];
+    if (edge.Source() >= v || edge.Destination() >= v ||
+        !std::isfinite(edge.Weight()) || edge.Weight() < 0)
+      corrupt("bad edge");
+  }
+  // Prim's reads weights from the adjacency, not the edges: each entry
+  // must agree with the edge it names
+  for (size_t u = 0; u < v; u++) {
+    for (size_t i = graph.offsets[u]; i < graph.offsets[u + 1]; i++) {
+      const unsigned int w = graph.neighbors[i], id = graph.edge_ids[i];
+      if (w >= v || id >= e)
+        corrupt("bad adjacency entry");
+      const Edge &edge = graph.edges[id];
+      if (!((edge.Source() == u && edge.Destination() == w) ||
+            (edge.Source() == w && edge.Destination() == u)) ||
+          !(graph.weights[i] == edge.Weight()))
+        corrupt("bad adjacency entry");
+    }
+  }
+
+  // Prim's jumps across the arrays; drop the sequential read-ahead
+  file->Advise(MADV_RANDOM);
+  graph.mapping = std::move(file);
+  return graph;
+}
+
+#endif  // GRAPH_FILE_H_
@@ -0,0 +1,218 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef GRAPH_GENERATOR_H_
+#define GRAPH_GENERATOR_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// What a GraphGenerator makes
+struct GeneratorOptions {
+  std::string type;           // geometric, er, grid, powerlaw, components
+  uint64_t num_vertices = 0;  // side * side for grid
+  uint64_t num_edges = 0;     // ignored for grid
+  uint64_t seed = 1;
+  uint64_t components = 16;   // for components
+  double skew = 3;            // for powerlaw
+};
+
+// GRAPH GENERATOR CLASS
+// Reproducible synthetic graphs: every ForEachEdge call emits the same
+// edges in the same order for the same options, drawing them one at a
+// time from a seeded generator, so callers can stream a graph of any size
+// and make several passes over it without storing it. Weights carry 5
+// decimals, as the EWD files print them, so text and binary output of one
+// graph hold exactly the same weights. Types:
+//
+//   geometric   points scattered over a grid of cells on the unit square,
+//               about 8 per cell, vertex ids in row-major cell order; each
+//               vertex links to random points of its own and the 8
+//               surrounding cells, weighted by distance
+//   er          Erdos-Renyi G(n, m): a random spanning path, so the graph
+//               is connected, plus uniformly random edges
+//   grid        a side x side lattice with random weights
+//   powerlaw    the spanning path plus edges whose endpoints are drawn as
+//               n * u^skew for uniform u, so that low ids become hubs
+//               whose degrees fall off as a power law
+//   components  @components disjoint er graphs, their vertices interleaved
+//               (vertex v belongs to component v mod components)
+//
+// Random edges never loop, but may repeat: prim_mst keeps the lightest
+// copy of a text edge, and a repeated binary edge cannot change the MST.
+class GraphGenerator {
+ public:
+  // checks @options; throws std::runtime_error if they make no graph
+  explicit GraphGenerator(const GeneratorOptions &options);
+  // return number of vertices
+  uint64_t NumVertices() const {
+    return num_vertices;
+  }
+  // return number of edges ForEachEdge emits
+  uint64_t NumEdges() const {
+    return num_edges;
+  }
+  // calls @fn(source, destination, weight) for every edge, always in the
+  // same order
+  template <typename Fn>
+  void ForEachEdge(Fn fn) const;
+
+ private:
+  GeneratorOptions options;
+  uint64_t num_vertices, num_edges;
+  uint64_t cells_per_side;  // geometric only
+
+  // Return @w rounded to 5 decimals
+  static double Round5(double w) {
+    return std::round(w * 1e5) / 1e5;
+  }
+  // Return a well mixed hash of @x (SplitMix64 finalizer)
+  static uint64_t Mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+  }
+  // Return a uniform number in [0, 1) fixed by @seed and @x
+  static double Unit(uint64_t seed, uint64_t x) {
+    return (Mix(seed ^ Mix(x)) >> 11) * 0x1p-53;
+  }
+  // Return first vertex of geometric cell @cell
+  uint64_t CellBegin(uint64_t cell) const {
+    uint64_t cells = cells_per_side * cells_per_side;
+    return (cell * num_vertices + cells - 1) / cells;
+  }
+  // Return coordinate @axis (0 or 1) of geometric vertex @v
+  double Coordinate(uint64_t v, int axis) const;
+  // Return cell holding geometric vertex @v
+  uint64_t CellOf(uint64_t v) const {
+    uint64_t cells = cells_per_side * cells_per_side;
+    uint64_t cell = v * cells / num_vertices;
+    // integer rounding may put v in the cell after
+    while (CellBegin(cell + 1) <= v)
+      cell++;
+    while (CellBegin(cell) > v)
+      cell--;
+    return cell;
+  }
+};
+
+inline GraphGenerator::GraphGenerator(const GeneratorOptions &options)
+  : options(options),
+    num_vertices(options.num_vertices),
+    num_edges(options.num_edges),
+    cells_per_side(1) {
+  const std::string &type = options.type;
+  if (type == "grid") {
+    uint64_t side = std::llround(std::sqrt(double(num_vertices)));
+    if (side < 1 || side * side != num_vertices)
+      throw std::runtime_error("Error: grid needs a square vertex count");
+    num_edges = 2 * side * (side - 1);
+  } else if (type == "geometric") {
+    if (num_vertices < 2)
+      throw std::runtime_error("Error: geometric needs 2 vertices or more");
+    cells_per_side = std::max<uint64_t>(1, std::sqrt(num_vertices / 8.0));
+  } else if (type == "er" || type == "powerlaw" || type == "components") {
+    uint64_t parts = type == "components" ? options.components : 1;
+    if (parts < 1 || num_vertices < 2 * parts)
+      throw std::runtime_error("Error: need 2 vertices or more per "
+                               "component");
+    if (num_edges < num_vertices - parts)
+      throw std::runtime_error("Error: " + type + " needs at least " +
+                               std::to_string(num_vertices - parts) +
+                               " edges to be connected");
+    if (type == "powerlaw" && !(options.skew >= 1))
+      throw std::runtime_error("Error: skew must be at least 1");
+  } else {
+    throw std::runtime_error("Error: unknown graph type " + type);
+  }
+  if (num_vertices > ~0U || num_edges > ~0U)
+    throw std::runtime_error("Error: at most 2^32 - 1 vertices and edges");
+}
+
+inline double GraphGenerator::Coordinate(uint64_t v, int axis) const {
+  uint64_t cell = CellOf(v);
+  uint64_t corner = axis ? cell / cells_per_side : cell % cells_per_side;
+  return (corner + Unit(options.seed, 2 * v + axis)) / cells_per_side;
+}
+
+template <typename Fn>
+void GraphGenerator::ForEachEdge(Fn fn) const {
+  std::mt19937_64 gen(options.seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  const uint64_t n = num_vertices;
+  auto below = [&gen](uint64_t bound) {
+    return std::uniform_int_distribution<uint64_t>(0, bound - 1)(gen);
+  };
+  const std::string &type = options.type;
+
+  if (type == "grid") {
+    uint64_t side = std::llround(std::sqrt(double(n)));
+    for (uint64_t r = 0; r < side; r++) {
+      for (uint64_t c = 0; c < side; c++) {
+        uint64_t v = r * side + c;
+        if (c + 1 < side)
+          fn(v, v + 1, Round5(unit(gen)));
+        if (r + 1 < side)
+          fn(v, v + side, Round5(unit(gen)));
+      }
+    }
+    return;
+  }
+
+  if (type == "geometric") {
+    const int64_t side = cells_per_side;
+    for (uint64_t v = 0; v < n; v++) {
+      // an even share of the edges per vertex
+      uint64_t count = num_edges / n + (v < num_edges % n ? 1 : 0);
+      int64_t cell = CellOf(v);
+      int64_t cx = cell % side, cy = cell / side;
+      for (uint64_t k = 0; k < count; k++) {
+        uint64_t u = v;
+        while (u == v) {
+          int64_t x = std::min(side - 1, std::max<int64_t>(
+              0, cx + int64_t(below(3)) - 1));
+          int64_t y = std::min(side - 1, std::max<int64_t>(
+              0, cy + int64_t(below(3)) - 1));
+          uint64_t first = CellBegin(y * side + x);
+          uint64_t size = CellBegin(y * side + x + 1) - first;
+          if (size > 0)
+            u = first + below(size);
+        }
+        double dx = Coordinate(u, 0) - Coordinate(v, 0);
+        double dy = Coordinate(u, 1) - Coordinate(v, 1);
+        fn(v, u, Round5(std::sqrt(dx * dx + dy * dy)));
+      }
+    }
+    return;
+  }
+
+  // er, powerlaw and components: a spanning path through every component,
+  // then random edges inside a random component
+  const uint64_t parts = type == "components" ? options.components : 1;
+  for (uint64_t v = parts; v < n; v++)
+    fn(v - parts, v, Round5(unit(gen)));
+  for (uint64_t e = n - parts; e < num_edges; e++) {
+    uint64_t part = below(parts);
+    uint64_t size = (n - part + parts - 1) / parts;  // vertices of part
+    uint64_t a, b;
+    do {
+      if (type == "powerlaw") {
+        a = std::min<uint64_t>(size - 1, size * std::pow(unit(gen),
+                                                          options.skew));
+        b = std::min<uint64_t>(size - 1, size * std::pow(unit(gen),
+                                                          options.skew));
+      } else {
+        a = below(size);
+        b = below(size);
+      }
+    } while (a == b);
+    fn(a * parts + part, b * parts + part, Round5(unit(gen)));
+  }
+}
+
+#endif  // GRAPH_GENERATOR_H_
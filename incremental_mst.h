@@ -0,0 +1,105 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef INCREMENTAL_MST_H_
+#define INCREMENTAL_MST_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "link_cut_tree.h"
+#include "mst.h"
+#include "mst_result.h"
+
+// INCREMENTAL MIN SPANNING TREE CLASS
+// Minimum spanning forest kept up to date while edges are inserted. The
+// forest lives in a link-cut tree with one node per vertex and one per
+// tree edge, so an insertion costs O(log V) amortized: an edge between two
+// trees links them; an edge inside a tree replaces the heaviest edge on
+// the path between its endpoints if it is lighter, and is dropped
+// otherwise. Edges left out are forgotten, which is safe as long as no
+// edge is ever removed.
+class IncrementalMST {
+ public:
+  // starts from the minimum spanning forest @result of some graph
+  explicit IncrementalMST(const MSTResult &result);
+  // adds edge @e to the graph, return whether the forest changed
+  bool InsertEdge(const Edge &e);
+  // return number of vertices
+  size_t NumVertices() const {
+    return num_vertices;
+  }
+  // return sum of the tree edge weights, updated on every insertion
+  double TotalWeight() const {
+    return total_weight;
+  }
+  // return the current forest laid out like MST's
+  MSTResult Result() const;
+
+ private:
+  size_t num_vertices;
+  LinkCutTree forest;       // vertex v is node v, edges[i] is node n + i
+  std::vector<Edge> edges;  // the tree edges
+  double total_weight;
+
+  // Links a node for @e between its endpoints
+  void Link(const Edge &e);
+};
+
+inline IncrementalMST::IncrementalMST(const MSTResult &result)
+  : num_vertices(result.NumVertices()),
+    forest(result.NumVertices()),
+    total_weight(0) {
+  for (unsigned int v = 0; v < num_vertices; v++) {
+    if (!result.IsRoot(v))
+      Link(result.Edges()[v]);
+  }
+}
+
+inline void IncrementalMST::Link(const Edge &e) {
+  unsigned int x = forest.AddNode(e.Weight());
+  edges.push_back(e);
+  forest.Link(e.Source(), x);
+  forest.Link(x, e.Destination());
+  total_weight += e.Weight();
+}
+
+inline bool IncrementalMST::InsertEdge(const Edge &e) {
+  for (unsigned int v : {e.Source(), e.Destination()}) {
+    if (v >= num_vertices)
+      throw std::runtime_error("Invalid vertex number " + std::to_string(v));
+  }
+  if (e.Source() == e.Destination())
+    return false;
+
+  if (!forest.Connected(e.Source(), e.Destination())) {
+    Link(e);
+    return true;
+  }
+
+  // the heaviest node on a path between two vertices is an edge node
+  unsigned int x = forest.PathMax(e.Source(), e.Destination());
+  if (!(e.Weight() < forest.Weight(x)))
+    return false;
+
+  // reuse the node of the edge swapped out
+  Edge &old = edges[x - num_vertices];
+  forest.Cut(old.Source(), x);
+  forest.Cut(x, old.Destination());
+  total_weight += e.Weight() - old.Weight();
+  old = e;
+  forest.SetWeight(x, e.Weight());
+  forest.Link(e.Source(), x);
+  forest.Link(x, e.Destination());
+  return true;
+}
+
+inline MSTResult IncrementalMST::Result() const {
+  std::vector<unsigned int> ids(edges.size());
+  for (unsigned int i = 0; i < ids.size(); i++)
+    ids[i] = i;
+  return MSTResult(RootForest(num_vertices, edges, ids));
+}
+
+#endif  // INCREMENTAL_MST_H_
@@ -0,0 +1,123 @@
+// @copyright 2019 Shivani Parekh and Urmi Lalchandani
+
+#ifndef INDEX_ARRAY_PQ_H_
+#define INDEX_ARRAY_PQ_H_
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "pq_counters.h"
+#include "prim_key.h"
+#include "simd_argmin.h"
+
+// Indexed min-priority queue as a plain array of keys, with the same
+// interface as IndexMinPQ. Push and ChangeKey only store the key; Top
+// scans the whole array with ArgMin, O(capacity), and keeps the result
+// until the keys change. This is Prim's algorithm for dense graphs, whose
+// key changes outnumber the pops. Keys are doubles or PrimKeys, stored as
+// an array of weights (KeyWeight) for ArgMin and one of tie-breaks
+// (KeyTie); equal keys come out lowest index first. Weights must be
+// finite: infinity marks the indexes not contained. With @Counted the
+// queue counts its operations into Counters().
+template <typename K = double, bool Counted = false>
+class IndexArrayPQ {
+ public:
+  static constexpr bool kCounted = Counted;
+
+  // Constructor with max number of indexes
+  explicit IndexArrayPQ(size_t capacity)
+    : weights(capacity, std::numeric_limits<double>::infinity()),
+      ties(capacity, 0),
+      cur_size(0),
+      top(kNone) {}
+  // Return number of items
+  size_t Size() {
+    return cur_size;
+  }
+  // Return top (ie index associated to minimum key)
+  unsigned int Top();
+  // Remove top
+  void Pop();
+  // Associates @key with index @idx
+  void Push(const K &key, unsigned int idx);
+  // Return whether @idx is a valid index
+  bool Contains(unsigned int idx) {
+    if (idx >= weights.size())
+      throw std::overflow_error("Index invalid!");
+    return weights[idx] != std::numeric_limits<double>::infinity();
+  }
+  // Change key associated to index @idx
+  void ChangeKey(const K &key, unsigned int idx);
+  // Return operation counts so far (all zero unless Counted)
+  MSTCounters &Counters() {
+    return counters;
+  }
+
+ private:
+  static constexpr unsigned int kNone = ~0U;
+
+  // Private members
+  std::vector<double> weights;     // infinity if not contained
+  std::vector<unsigned int> ties;  // tie-break among equal weights
+  size_t cur_size;
+  unsigned int top;                // result of the last scan, kNone if stale
+  MSTCounters counters;
+};
+
+template <typename K, bool Counted>
+unsigned int IndexArrayPQ<K, Counted>::Top() {
+  if (!Size())
+    throw std::underflow_error("Priority queue underflow!");
+  if (top == kNone) {
+    bool tied;
+    top = ArgMin(weights.data(), weights.size(), &tied);
+    // ArgMin finds the first of the lightest; a later one may have the
+    // smaller tie-break (plain numbers have none)
+    if (!std::is_arithmetic<K>::value && tied) {
+      const double w = weights[top];
+      for (size_t i = top + 1; i < weights.size(); i++) {
+        if (weights[i] == w && ties[i] < ties[top])
+          top = i;
+      }
+    }
+  }
+  return top;
+}
+
+template <typename K, bool Counted>
+void IndexArrayPQ<K, Counted>::Pop() {
+  if (!Size())
+    throw std::underflow_error("Empty priority queue!");
+  weights[Top()] = std::numeric_limits<double>::infinity();
+  top = kNone;
+  cur_size--;
+  if constexpr (Counted)
+    counters.pop++;
+}
+
+template <typename K, bool Counted>
+void IndexArrayPQ<K, Counted>::Push(const K &key, unsigned int idx) {
+  if (Contains(idx))
+    throw std::runtime_error("Index already exists!");
+  weights[idx] = KeyWeight(key);
+  ties[idx] = KeyTie(key);
+  top = kNone;
+  cur_size++;
+  if constexpr (Counted)
+    counters.push++;
+}
+
+template <typename K, bool Counted>
+void IndexArrayPQ<K, Counted>::ChangeKey(const K &key, unsigned int idx) {
+  if (!Contains(idx))
+    throw std::runtime_error("Index does not exist!");
+  weights[idx] = KeyWeight(key);
+  ties[idx] = KeyTie(key);
+  top = kNone;
+  if constexpr (Counted)
+    counters.change_key++;
+}
+
+#endif  // INDEX_ARRAY_PQ_H_
@@ -5,13 +5,120 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <new>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 #include <vector>
+#include "pq_counters.h"
+
+// Allocator returning memory aligned to @Align bytes, so that a heap's
+// sibling groups can be laid out on cache-line boundaries
+template <typename T, size_t Align = 64>
+struct AlignedAllocator {
+  typedef T value_type;
+  template <typename U>
+  struct rebind {
+    typedef AlignedAllocator<U, Align> other;
+  };
+
+  AlignedAllocator() {}
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Align> &) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t(Align)));
+  }
+  void deallocate(T *p, size_t) {
+    ::operator delete(p, std::align_val_t(Align));
+  }
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Align> &) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Align> &) const {
+    return false;
+  }
+};
+
+// Heap slot layouts. By default a slot holds only the index and keys live
+// in a side table indexed by it; with InlineKeys the key is stored in the
+// slot next to its index, so comparisons skip one indirection.
+template <typename K, bool InlineKeys>
+class IndexMinPQSlots;
 
 template <typename K>
+class IndexMinPQSlots<K, false> {
+ public:
+  IndexMinPQSlots(size_t capacity, size_t slots)
+    : heap(slots), keys(capacity) {}
+  const K &Key(unsigned int pos) const {
+    return keys[heap[pos]];
+  }
+  unsigned int Index(unsigned int pos) const {
+    return heap[pos];
+  }
+  void Set(unsigned int pos, const K &key, unsigned int idx) {
+    heap[pos] = idx;
+    keys[idx] = key;
+  }
+  void SetKey(unsigned int pos, const K &key) {
+    keys[heap[pos]] = key;
+  }
+  void Swap(unsigned int i, unsigned int j) {
+    std::swap(heap[i], heap[j]);
+  }
+
+ private:
+  std::vector<unsigned int, AlignedAllocator<unsigned int>> heap;
+  std::vector<K> keys;
+};
+
+template <typename K>
+class IndexMinPQSlots<K, true> {
+ public:
+  IndexMinPQSlots(size_t, size_t slots) : heap(slots) {}
+  const K &Key(unsigned int pos) const {
+    return heap[pos].key;
+  }
+  unsigned int Index(unsigned int pos) const {
+    return heap[pos].idx;
+  }
+  void Set(unsigned int pos, const K &key, unsigned int idx) {
+    heap[pos].key = key;
+    heap[pos].idx = idx;
+  }
+  void SetKey(unsigned int pos, const K &key) {
+    heap[pos].key = key;
+  }
+  void Swap(unsigned int i, unsigned int j) {
+    std::swap(heap[i], heap[j]);
+  }
+
+ private:
+  struct Slot {
+    K key;
+    unsigned int idx;
+  };
+  std::vector<Slot, AlignedAllocator<Slot>> heap;
+};
+
+// Indexed min-priority queue as a @D-ary heap (D = 2, 4, 8, ...). The root
+// sits at position D - 1, which puts the D children of every node at a
+// position that is a multiple of D: with the heap array aligned, one
+// node's children share a cache line. For D = 2 this is the classic
+// 1-based binary heap. With @Counted the queue counts its operations and
+// node moves into Counters(); without, the counting compiles away.
+template <typename K, unsigned int D = 2, bool InlineKeys = false,
+          bool Counted = false>
 class IndexMinPQ {
+  static_assert(D >= 2, "heap arity must be at least 2");
+
  public:
+  static constexpr bool kCounted = Counted;
+
   // Constructor with max number of indexes
   explicit IndexMinPQ(size_t capacity);
   // Return number of items
@@ -26,27 +133,41 @@ class IndexMinPQ {
   bool Contains(unsigned int idx);
   // Change key associated to index @idx
   void ChangeKey(const K &key, unsigned int idx);
+  // Associates every (key, idx) pair of @items, as Push does one by one;
+  // a batch big against the heap is appended and heapified bottom-up in
+  // O(size) instead of O(items log size). Throws, leaving the queue as it
+  // was, if an index is invalid, already there or repeated in @items.
+  void PushBatch(const std::vector<std::pair<K, unsigned int>> &items);
+  // Changes the key of every (key, idx) pair of @items, in order, as
+  // ChangeKey does one by one; a big batch sets every key, then repairs
+  // the heap once bottom-up. Throws, changing nothing, if an index is
+  // invalid or not there.
+  void ChangeKeyBatch(const std::vector<std::pair<K, unsigned int>> &items);
+  // Return operation counts so far (all zero unless Counted)
+  MSTCounters &Counters() {
+    return counters;
+  }
 
  private:
   // Private members
   size_t capacity;
   size_t cur_size;
-  std::vector<K> keys;
-  std::vector<unsigned int> heap_to_idx;
+  IndexMinPQSlots<K, InlineKeys> slots;
   std::vector<unsigned int> idx_to_heap;
+  MSTCounters counters;
 
   // Helper methods for indices
   unsigned int Root() {
-    return 1;
+    return D - 1;
   }
   unsigned int Parent(unsigned int i) {
-    return i / 2;
+    return i / D + D - 2;
   }
-  unsigned int LeftChild(unsigned int i) {
-    return 2 * i;
+  unsigned int FirstChild(unsigned int i) {
+    return D * (i - D + 2);
   }
-  unsigned int RightChild(unsigned int i) {
-    return 2 * i + 1;
+  unsigned int LastNode() {
+    return Root() + cur_size - 1;
   }
 
   // Helper methods for node testing
@@ -54,24 +175,34 @@ class IndexMinPQ {
     return i != Root();
   }
   bool IsNode(unsigned int i) {
-    return i <= cur_size;
+    return i <= LastNode();
   }
   bool GreaterNode(unsigned int i, unsigned int j) {
     // Return true if node at index i is greater than node at index j, false
     // otherwise
-    return (keys[heap_to_idx[i]] > keys[heap_to_idx[j]]);
+    return (slots.Key(i) > slots.Key(j));
   }
 
   // Helper methods for restructuring
   void SwapNodes(unsigned int i, unsigned int j) {
     // Swap nodes in heap
-    std::swap(heap_to_idx[i], heap_to_idx[j]);
+    slots.Swap(i, j);
     // Update inverse mappings
-    idx_to_heap[heap_to_idx[i]] = i;
-    idx_to_heap[heap_to_idx[j]] = j;
+    idx_to_heap[slots.Index(i)] = i;
+    idx_to_heap[slots.Index(j)] = j;
   }
   void PercolateUp(unsigned int i);
   void PercolateDown(unsigned int i);
+  // Restores heap-order over the whole heap, bottom-up
+  void Build();
+  // Return whether repairing @count nodes one by one costs more than
+  // Build()
+  bool BuildPays(size_t count) {
+    size_t levels = 1;
+    for (size_t n = cur_size; n >= D; n /= D)
+      levels++;
+    return count * levels >= cur_size;
+  }
 
   // Helper method to check heap-order (useful for debugging)
   void CheckHeapOrder(unsigned int i) {
@@ -81,51 +212,53 @@ class IndexMinPQ {
       std::stringstream ss;
       ss << "Heap order error: "
           << "Parent ("
-            << Parent(i) << ": " << heap_to_idx[Parent(i)] << ", "
-            << keys[heap_to_idx[Parent(i)]] << ")"
+            << Parent(i) << ": " << slots.Index(Parent(i)) << ", "
+            << slots.Key(Parent(i)) << ")"
           << " bigger than Child ("
-            << i << ": " << heap_to_idx[i] << ", "
-            << keys[heap_to_idx[i]] << ")";
+            << i << ": " << slots.Index(i) << ", "
+            << slots.Key(i) << ")";
       throw std::runtime_error(ss.str());
     }
-    CheckHeapOrder(LeftChild(i));
-    CheckHeapOrder(RightChild(i));
+    for (unsigned int c = FirstChild(i); c < FirstChild(i) + D; c++)
+      CheckHeapOrder(c);
   }
 };
 
-template <typename K>
-IndexMinPQ<K>::IndexMinPQ(size_t capacity)
+template <typename K, unsigned int D, bool InlineKeys, bool Counted>
+IndexMinPQ<K, D, InlineKeys, Counted>::IndexMinPQ(size_t capacity)
   : capacity(capacity),
-    keys(capacity),
-    heap_to_idx(capacity + 1),
+    slots(capacity, capacity + D),
     idx_to_heap(capacity, 0) {
       cur_size = 0;
     }
 
-template <typename K>
-size_t IndexMinPQ<K>::Size() {
+template <typename K, unsigned int D, bool InlineKeys, bool Counted>
+size_t IndexMinPQ<K, D, InlineKeys, Counted>::Size() {
   return cur_size;
 }
 
-template <typename K>
-unsigned int IndexMinPQ<K>::Top(void) {
+template <typename K, unsigned int D, bool InlineKeys, bool Counted>
+unsigned int IndexMinPQ<K, D, InlineKeys, Counted>::Top(void) {
   if (!Size())
     throw std::underflow_error("Priority queue underflow!");
 
   // return index at top of priority queue
-  return heap_to_idx[1];
+  return slots.Index(Root());
 }
 
-template <typename K>
-void IndexMinPQ<K>::PercolateUp(unsigned int i) {
+template <typename K, unsigned int D, bool InlineKeys, bool Counted>
+void IndexMinPQ<K, D, InlineKeys, Counted>::PercolateUp(unsigned int i) {
   while (HasParent(i) && GreaterNode(Parent(i), i)) {
     SwapNodes(Parent(i), i);
+    if constexpr (Counted)
+      counters.percolate_steps++;
     i = Parent(i);
   }
 }
 
-template <typename K>
-void IndexMinPQ<K>::Push(const K &key, unsigned int idx) {
+template <typename K, unsigned int D, bool InlineKeys, bool Counted>
+void IndexMinPQ<K, D, InlineKeys, Counted>::Push(const K &key,
+                                                  unsigned int idx) {
   if (idx >= capacity)
     throw std::overflow_error("Index invalid!");
   if (Contains(idx))
@@ -136,36 +269,42 @@ void IndexMinPQ<K>::Push(const K &key, unsigned int idx) {
   //  - Set key in key vector
   // 2. Percolate up
   // (for debugging, check heap order)
+  if constexpr (Counted)
+    counters.push++;
   cur_size++;
-  heap_to_idx[cur_size] = idx;
-  idx_to_heap[idx] = cur_size;
-  keys[idx] = key;
-  PercolateUp(cur_size);
+  slots.Set(LastNode(), key, idx);
+  idx_to_heap[idx] = LastNode();
+  PercolateUp(LastNode());
 //  CheckHeapOrder(Root());
 }
 
-template <typename K>
-void IndexMinPQ<K>::PercolateDown(unsigned int i) {
-  // While node has at least one child (if one, necessarily on the left)
-  while (IsNode(LeftChild(i))) {
-    // Find smallest children between left and right if any
-    unsigned int child = LeftChild(i);
-    if (IsNode(RightChild(i)) && GreaterNode(LeftChild(i), RightChild(i)))
-      child = RightChild(i);
+template <typename K, unsigned int D, bool InlineKeys, bool Counted>
+void IndexMinPQ<K, D, InlineKeys, Counted>::PercolateDown(unsigned int i) {
+  // While node has at least one child (the first one, if any)
+  while (IsNode(FirstChild(i))) {
+    // Find smallest children among the ones that exist
+    unsigned int child = FirstChild(i);
+    unsigned int last = std::min(FirstChild(i) + D - 1, LastNode());
+    for (unsigned int c = child + 1; c <= last; c++) {
+      if (GreaterNode(child, c))
+        child = c;
+    }
 
     // Exchange node with child to restore heap-order if necessary
     if (GreaterNode(i, child))
       SwapNodes(i, child);
     else
       break;
+    if constexpr (Counted)
+      counters.percolate_steps++;
 
     // Do it again, one level down
     i = child;
   }
 }
 
-template <typename K>
-void IndexMinPQ<K>::Pop() {
+template <typename K, unsigned int D, bool InlineKeys, bool Counted>
+void IndexMinPQ<K, D, InlineKeys, Counted>::Pop() {
   if (!Size())
     throw std::underflow_error("Empty priority queue!");
 
@@ -174,22 +313,26 @@ void IndexMinPQ<K>::Pop() {
   // 3. Mark idx_to_heap mapping as invalid
   // (for debugging, check heap order)
 
+  if constexpr (Counted)
+    counters.pop++;
   int min = Top();
-  SwapNodes(Root(), cur_size--);
+  SwapNodes(Root(), LastNode());
+  cur_size--;
   PercolateDown(Root());
   idx_to_heap[min] = 0;
 //  CheckHeapOrder(Root());
 }
 
-template <typename K>
-bool IndexMinPQ<K>::Contains(unsigned int idx) {
+template <typename K, unsigned int D, bool InlineKeys, bool Counted>
+bool IndexMinPQ<K, D, InlineKeys, Counted>::Contains(unsigned int idx) {
   if (idx >= capacity)
     throw std::overflow_error("Index invalid!");
   return (idx_to_heap[idx] != 0);
 }
 
-template <typename K>
-void IndexMinPQ<K>::ChangeKey(const K &key, unsigned int idx) {
+template <typename K, unsigned int D, bool InlineKeys, bool Counted>
+void IndexMinPQ<K, D, InlineKeys, Counted>::ChangeKey(const K &key,
+                                                       unsigned int idx) {
   if (idx >= capacity)
     throw std::overflow_error("Index invalid!");
   if (!Contains(idx))
@@ -199,9 +342,75 @@ void IndexMinPQ<K>::ChangeKey(const K &key, unsigned int idx) {
   // 2. Restore heap-order
   //  - Note that key might be have increased _or_ decreased
   // (for debugging, check heap order)
-  keys[idx] = key;
+  if constexpr (Counted)
+    counters.change_key++;
+  slots.SetKey(idx_to_heap[idx], key);
   PercolateDown(idx_to_heap[idx]);
   PercolateUp(idx_to_heap[idx]);
 }
 
+template <typename K, unsigned int D, bool InlineKeys, bool Counted>
+void IndexMinPQ<K, D, InlineKeys, Counted>::Build() {
+  if (cur_size < 2)
+    return;
+  // every node with children, deepest first
+  for (unsigned int i = Parent(LastNode()) + 1; i-- > Root();)
+    PercolateDown(i);
+}
+
+template <typename K, unsigned int D, bool InlineKeys, bool Counted>
+void IndexMinPQ<K, D, InlineKeys, Counted>::PushBatch(
+    const std::vector<std::pair<K, unsigned int>> &items) {
+  // 1. Append every item at the end, undoing the appends on a bad index
+  // 2. Percolate each up, or heapify the whole heap
+  size_t first = cur_size;
+  for (const auto &item : items) {
+    unsigned int idx = item.second;
+    if (idx >= capacity || Contains(idx)) {
+      for (unsigned int i = Root() + first; i <= LastNode(); i++)
+        idx_to_heap[slots.Index(i)] = 0;
+      cur_size = first;
+      if (idx >= capacity)
+        throw std::overflow_error("Index invalid!");
+      throw std::runtime_error("Index already exists!");
+    }
+    cur_size++;
+    slots.Set(LastNode(), item.first, idx);
+    idx_to_heap[idx] = LastNode();
+  }
+  if constexpr (Counted)
+    counters.push += items.size();
+
+  if (BuildPays(items.size())) {
+    Build();
+  } else {
+    for (unsigned int i = Root() + first; i <= LastNode(); i++)
+      PercolateUp(i);
+  }
+//  CheckHeapOrder(Root());
+}
+
+template <typename K, unsigned int D, bool InlineKeys, bool Counted>
+void IndexMinPQ<K, D, InlineKeys, Counted>::ChangeKeyBatch(
+    const std::vector<std::pair<K, unsigned int>> &items) {
+  for (const auto &item : items) {
+    if (item.second >= capacity)
+      throw std::overflow_error("Index invalid!");
+    if (!Contains(item.second))
+      throw std::runtime_error("Index does not exist!");
+  }
+
+  if (!BuildPays(items.size())) {
+    for (const auto &item : items)
+      ChangeKey(item.first, item.second);
+    return;
+  }
+  if constexpr (Counted)
+    counters.change_key += items.size();
+  for (const auto &item : items)
+    slots.SetKey(idx_to_heap[item.second], item.first);
+  Build();
+//  CheckHeapOrder(Root());
+}
+
 #endif  // INDEX_MIN_PQ_H_
@@ -0,0 +1,199 @@
+// @copyright 2019 Shivani Parekh and Urmi Lalchandani
+
+#ifndef INDEX_PAIRING_PQ_H_
+#define INDEX_PAIRING_PQ_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Indexed min-priority queue as a pairing heap, with the same interface as
+// IndexMinPQ. Push and a decreasing ChangeKey are O(1) (a meld with the
+// root), Pop is O(log n) amortized; nodes are the indexes themselves, so
+// the tree lives in flat per-index link arrays.
+template <typename K>
+class IndexPairingPQ {
+ public:
+  // Constructor with max number of indexes
+  explicit IndexPairingPQ(size_t capacity);
+  // Return number of items
+  size_t Size();
+  // Return top (ie index associated to minimum key)
+  unsigned int Top();
+  // Remove top
+  void Pop();
+  // Associates @key with index @idx
+  void Push(const K &key, unsigned int idx);
+  // Return whether @idx is a valid index
+  bool Contains(unsigned int idx);
+  // Change key associated to index @idx
+  void ChangeKey(const K &key, unsigned int idx);
+
+ private:
+  static constexpr unsigned int kNil = ~0U;
+
+  // Private members
+  size_t capacity;
+  size_t cur_size;
+  unsigned int root;
+  std::vector<K> keys;
+  std::vector<unsigned int> child;    // leftmost child
+  std::vector<unsigned int> sibling;  // next sibling to the right
+  std::vector<unsigned int> prev;     // left sibling, or parent if leftmost
+  std::vector<bool> contained;
+
+  // Links the roots @a and @b, return the new root
+  unsigned int Meld(unsigned int a, unsigned int b) {
+    if (a == kNil)
+      return b;
+    if (b == kNil)
+      return a;
+    if (keys[b] < keys[a])
+      std::swap(a, b);
+    // b becomes the leftmost child of a
+    sibling[b] = child[a];
+    if (child[a] != kNil)
+      prev[child[a]] = b;
+    prev[b] = a;
+    child[a] = b;
+    sibling[a] = kNil;
+    prev[a] = kNil;
+    return a;
+  }
+  // Detaches the subtree rooted at non-root node @i from its parent
+  void Cut(unsigned int i) {
+    if (child[prev[i]] == i)
+      child[prev[i]] = sibling[i];
+    else
+      sibling[prev[i]] = sibling[i];
+    if (sibling[i] != kNil)
+      prev[sibling[i]] = prev[i];
+    sibling[i] = kNil;
+    prev[i] = kNil;
+  }
+  // Two-pass pairing of the sibling list starting at @first, return root
+  unsigned int MergePairs(unsigned int first);
+};
+
+template <typename K>
+IndexPairingPQ<K>::IndexPairingPQ(size_t capacity)
+  : capacity(capacity),
+    cur_size(0),
+    root(kNil),
+    keys(capacity),
+    child(capacity, kNil),
+    sibling(capacity, kNil),
+    prev(capacity, kNil),
+    contained(capacity, false) {}
+
+template <typename K>
+size_t IndexPairingPQ<K>::Size() {
+  return cur_size;
+}
+
+template <typename K>
+unsigned int IndexPairingPQ<K>::Top() {
+  if (!Size())
+    throw std::underflow_error("Priority queue underflow!");
+  return root;
+}
+
+template <typename K>
+unsigned int IndexPairingPQ<K>::MergePairs(unsigned int first) {
+  if (first == kNil)
+    return kNil;
+
+  // 1. Left to right, meld siblings in pairs; the pair roots are chained
+  // back to front through their sibling links
+  unsigned int pairs = kNil;
+  while (first != kNil) {
+    unsigned int a = first;
+    unsigned int b = sibling[a];
+    first = (b != kNil) ? sibling[b] : kNil;
+    sibling[a] = prev[a] = kNil;
+    if (b != kNil)
+      sibling[b] = prev[b] = kNil;
+    unsigned int pair = Meld(a, b);
+    sibling[pair] = pairs;
+    pairs = pair;
+  }
+
+  // 2. Right to left, meld every pair root into the accumulated heap
+  unsigned int result = pairs;
+  pairs = sibling[pairs];
+  sibling[result] = kNil;
+  while (pairs != kNil) {
+    unsigned int next = sibling[pairs];
+    sibling[pairs] = kNil;
+    result = Meld(result, pairs);
+    pairs = next;
+  }
+  return result;
+}
+
+template <typename K>
+void IndexPairingPQ<K>::Push(const K &key, unsigned int idx) {
+  if (idx >= capacity)
+    throw std::overflow_error("Index invalid!");
+  if (Contains(idx))
+    throw std::runtime_error("Index already exists!");
+
+  keys[idx] = key;
+  child[idx] = sibling[idx] = prev[idx] = kNil;
+  contained[idx] = true;
+  cur_size++;
+  root = Meld(root, idx);
+}
+
+template <typename K>
+void IndexPairingPQ<K>::Pop() {
+  if (!Size())
+    throw std::underflow_error("Empty priority queue!");
+
+  unsigned int min = root;
+  root = MergePairs(child[min]);
+  child[min] = kNil;
+  contained[min] = false;
+  cur_size--;
+}
+
+template <typename K>
+bool IndexPairingPQ<K>::Contains(unsigned int idx) {
+  if (idx >= capacity)
+    throw std::overflow_error("Index invalid!");
+  return contained[idx];
+}
+
+template <typename K>
+void IndexPairingPQ<K>::ChangeKey(const K &key, unsigned int idx) {
+  if (idx >= capacity)
+    throw std::overflow_error("Index invalid!");
+  if (!Contains(idx))
+    throw std::runtime_error("Index does not exist!");
+
+  if (!(keys[idx] < key)) {
+    // Decrease: cut the subtree out and meld it back with the root
+    keys[idx] = key;
+    if (idx != root) {
+      Cut(idx);
+      root = Meld(root, idx);
+    }
+    return;
+  }
+
+  // Increase: the children may now be smaller, so take the node out,
+  // merge its children back in and reinsert it alone
+  unsigned int children = MergePairs(child[idx]);
+  child[idx] = kNil;
+  if (idx == root) {
+    root = children;
+  } else {
+    Cut(idx);
+    root = Meld(root, children);
+  }
+  keys[idx] = key;
+  root = Meld(root, idx);
+}
+
+#endif  // INDEX_PAIRING_PQ_H_
@@ -0,0 +1,276 @@
+// @copyright 2019 Shivani Parekh and Urmi Lalchandani
+
+#ifndef INDEX_RADIX_PQ_H_
+#define INDEX_RADIX_PQ_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "pq_counters.h"
+#include "prim_key.h"
+
+// Indexed min-priority queue as a radix heap, with the same interface as
+// IndexMinPQ. Keys are unsigned integers, non-negative floating point
+// numbers or PrimKeys; all map to 64-bit radix keys that sort like the
+// keys do, a PrimKey by its weight, with its tie-break (KeyTie) kept
+// alongside to order equal weights.
+//
+// Every item is filed in bucket b = bit length of (key XOR last), where
+// last is the key of the most recent minimum. When keys are monotone (no
+// key pushed below the last minimum) each item moves down at most 64
+// buckets over its lifetime. Prim's algorithm pushes keys below the last
+// minimum all the time, so bucket 0, which holds every key at or below
+// last, is a binary heap on the exact keys and tie-breaks: an operation
+// there costs O(log V) and never a scan. With @Counted the queue counts
+// its operations, and as percolate_steps its heap moves and moves between
+// buckets, into Counters().
+template <typename K, bool Counted = false>
+class IndexRadixPQ {
+ public:
+  static constexpr bool kCounted = Counted;
+
+  // Constructor with max number of indexes
+  explicit IndexRadixPQ(size_t capacity);
+  // Return number of items
+  size_t Size();
+  // Return top (ie index associated to minimum key)
+  unsigned int Top();
+  // Remove top
+  void Pop();
+  // Associates @key with index @idx
+  void Push(const K &key, unsigned int idx);
+  // Return whether @idx is a valid index
+  bool Contains(unsigned int idx);
+  // Change key associated to index @idx
+  void ChangeKey(const K &key, unsigned int idx);
+  // Return operation counts so far (all zero unless Counted)
+  MSTCounters &Counters() {
+    return counters;
+  }
+
+ private:
+  static constexpr unsigned int kBuckets = 65;
+  static constexpr unsigned int kNone = ~0U;
+
+  // Private members
+  size_t capacity;
+  size_t cur_size;
+  uint64_t last;
+  std::vector<uint64_t> keys;
+  std::vector<unsigned int> ties;  // KeyTie of the key per index
+  std::vector<std::vector<unsigned int>> buckets;  // bucket 0 is a heap
+  std::vector<unsigned int> idx_to_bucket;  // kNone if not contained
+  std::vector<unsigned int> idx_to_pos;     // position inside its bucket
+  std::vector<unsigned int> scratch;        // bucket being redistributed
+  MSTCounters counters;
+
+  // Return the radix image of @key
+  static uint64_t Radix(const K &key) {
+    if constexpr (!std::is_integral<K>::value) {
+      // non-negative IEEE doubles order like their bit patterns, once -0.0
+      // (sign bit set) is made +0.0
+      double d = KeyWeight(key);
+      if (d == 0)
+        d = 0;
+      uint64_t bits;
+      std::memcpy(&bits, &d, sizeof(bits));
+      return bits;
+    } else {
+      return key;
+    }
+  }
+  // Return whether index @a comes before index @b in bucket 0
+  bool Less(unsigned int a, unsigned int b) const {
+    return keys[a] < keys[b] || (keys[a] == keys[b] && ties[a] < ties[b]);
+  }
+  // Return bucket of radix key @k
+  unsigned int BucketOf(uint64_t k) {
+    return k <= last ? 0 : 64 - __builtin_clzll(k ^ last);
+  }
+  // Places @idx at @pos of bucket 0
+  void Place(unsigned int idx, size_t pos) {
+    buckets[0][pos] = idx;
+    idx_to_pos[idx] = pos;
+  }
+  // Moves the item at @pos of bucket 0 up until its parent is no larger
+  void SiftUp(size_t pos);
+  // Moves the item at @pos of bucket 0 down until no child is smaller
+  void SiftDown(size_t pos);
+  void Insert(unsigned int idx);
+  void Remove(unsigned int idx);
+  // Refills bucket 0 from the first non-empty bucket when it runs dry
+  void Refill();
+};
+
+template <typename K, bool Counted>
+IndexRadixPQ<K, Counted>::IndexRadixPQ(size_t capacity)
+  : capacity(capacity),
+    cur_size(0),
+    last(0),
+    keys(capacity),
+    ties(capacity, 0),
+    buckets(kBuckets),
+    idx_to_bucket(capacity, kNone),
+    idx_to_pos(capacity, 0) {}
+
+template <typename K, bool Counted>
+size_t IndexRadixPQ<K, Counted>::Size() {
+  return cur_size;
+}
+
+template <typename K, bool Counted>
+void IndexRadixPQ<K, Counted>::SiftUp(size_t pos) {
+  std::vector<unsigned int> &heap = buckets[0];
+  const unsigned int idx = heap[pos];
+  while (pos > 0 && Less(idx, heap[(pos - 1) / 2])) {
+    Place(heap[(pos - 1) / 2], pos);
+    pos = (pos - 1) / 2;
+    if constexpr (Counted)
+      counters.percolate_steps++;
+  }
+  Place(idx, pos);
+}
+
+template <typename K, bool Counted>
+void IndexRadixPQ<K, Counted>::SiftDown(size_t pos) {
+  std::vector<unsigned int> &heap = buckets[0];
+  const unsigned int idx = heap[pos];
+  const size_t n = heap.size();
+  while (2 * pos + 1 < n) {
+    size_t child = 2 * pos + 1;
+    if (child + 1 < n && Less(heap[child + 1], heap[child]))
+      child++;
+    if (!Less(heap[child], idx))
+      break;
+    Place(heap[child], pos);
+    pos = child;
+    if constexpr (Counted)
+      counters.percolate_steps++;
+  }
+  Place(idx, pos);
+}
+
+template <typename K, bool Counted>
+void IndexRadixPQ<K, Counted>::Insert(unsigned int idx) {
+  unsigned int b = BucketOf(keys[idx]);
+  idx_to_bucket[idx] = b;
+  idx_to_pos[idx] = buckets[b].size();
+  buckets[b].push_back(idx);
+  if (b == 0)
+    SiftUp(idx_to_pos[idx]);
+}
+
+template <typename K, bool Counted>
+void IndexRadixPQ<K, Counted>::Remove(unsigned int idx) {
+  const unsigned int b = idx_to_bucket[idx];
+  std::vector<unsigned int> &bucket = buckets[b];
+  const size_t pos = idx_to_pos[idx];
+  unsigned int moved = bucket.back();
+  bucket.pop_back();
+  idx_to_bucket[idx] = kNone;
+  if (moved == idx)
+    return;
+  bucket[pos] = moved;
+  idx_to_pos[moved] = pos;
+  if (b == 0) {
+    SiftUp(pos);
+    SiftDown(idx_to_pos[moved]);
+  }
+}
+
+template <typename K, bool Counted>
+void IndexRadixPQ<K, Counted>::Refill() {
+  unsigned int b = 1;
+  while (buckets[b].empty())
+    b++;
+
+  // The smallest key of the bucket becomes the new last; every item of
+  // the bucket then lands in a lower bucket, the minimum in bucket 0
+  scratch.clear();
+  scratch.swap(buckets[b]);
+  last = keys[scratch[0]];
+  for (unsigned int idx : scratch) {
+    if (keys[idx] < last)
+      last = keys[idx];
+  }
+  for (unsigned int idx : scratch)
+    Insert(idx);
+  if constexpr (Counted)
+    counters.percolate_steps += scratch.size();
+}
+
+template <typename K, bool Counted>
+unsigned int IndexRadixPQ<K, Counted>::Top() {
+  if (!Size())
+    throw std::underflow_error("Priority queue underflow!");
+
+  if (buckets[0].empty())
+    Refill();
+  return buckets[0][0];
+}
+
+template <typename K, bool Counted>
+void IndexRadixPQ<K, Counted>::Push(const K &key, unsigned int idx) {
+  if (idx >= capacity)
+    throw std::overflow_error("Index invalid!");
+  if (Contains(idx))
+    throw std::runtime_error("Index already exists!");
+
+  keys[idx] = Radix(key);
+  ties[idx] = KeyTie(key);
+  Insert(idx);
+  cur_size++;
+  if constexpr (Counted)
+    counters.push++;
+}
+
+template <typename K, bool Counted>
+void IndexRadixPQ<K, Counted>::Pop() {
+  if (!Size())
+    throw std::underflow_error("Empty priority queue!");
+
+  Remove(Top());
+  cur_size--;
+  if constexpr (Counted)
+    counters.pop++;
+}
+
+template <typename K, bool Counted>
+bool IndexRadixPQ<K, Counted>::Contains(unsigned int idx) {
+  if (idx >= capacity)
+    throw std::overflow_error("Index invalid!");
+  return idx_to_bucket[idx] != kNone;
+}
+
+template <typename K, bool Counted>
+void IndexRadixPQ<K, Counted>::ChangeKey(const K &key, unsigned int idx) {
+  if (idx >= capacity)
+    throw std::overflow_error("Index invalid!");
+  if (!Contains(idx))
+    throw std::runtime_error("Index does not exist!");
+
+  const uint64_t k = Radix(key);
+  const unsigned int tie = KeyTie(key);
+  if (idx_to_bucket[idx] == 0 && k <= last) {
+    // stays in bucket 0: sift in place
+    const bool up = k < keys[idx] || (k == keys[idx] && tie < ties[idx]);
+    keys[idx] = k;
+    ties[idx] = tie;
+    if (up)
+      SiftUp(idx_to_pos[idx]);
+    else
+      SiftDown(idx_to_pos[idx]);
+  } else {
+    Remove(idx);
+    keys[idx] = k;
+    ties[idx] = tie;
+    Insert(idx);
+  }
+  if constexpr (Counted)
+    counters.change_key++;
+}
+
+#endif  // INDEX_RADIX_PQ_H_
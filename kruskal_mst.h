@@ -0,0 +1,83 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef KRUSKAL_MST_H_
+#define KRUSKAL_MST_H_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "graph.h"
+#include "mst.h"
+#include "mst_result.h"
+#include "parallel.h"
+#include "union_find.h"
+
+// KRUSKAL MIN SPANNING TREE CLASS
+// Minimum spanning forest straight from an edge list: the edges are sorted
+// by (weight, edge id) on several threads, then added lightest first
+// unless a union-find shows both ends already connected. Needs no
+// adjacency lists, so text input can skip building the Graph.
+//
+// The (weight, edge id) order is the one BoruvkaMST and MST (PrimKey)
+// use, so all three return the same forest, laid out like MST::Edges().
+class KruskalMST {
+ public:
+  // computes the minimum spanning forest of the @num_vertices vertex graph
+  // with edge list @edges, sorting on @num_threads threads
+  KruskalMST(size_t num_vertices, EdgeSpan edges,
+             unsigned int num_threads = 1);
+  // same for the edges of @graph
+  explicit KruskalMST(const Graph &graph, unsigned int num_threads = 1)
+    : KruskalMST(graph.NumVertices(), graph.Edges(), num_threads) {}
+  // return the computed forest
+  const MSTResult &Result() const {
+    return result;
+  }
+  // return the edge that connects each vertex to the tree
+  const std::vector<Edge> &Edges() const {
+    return result.Edges();
+  }
+  // print out the tree edges and total weight
+  void Print(OutputMode mode = OutputMode::kFull) const {
+    PrintMST(result, mode);
+  }
+
+ private:
+  // Sort record: 16 bytes, so the sort moves no more than it compares
+  struct Packed {
+    double weight;
+    unsigned int id;
+    bool operator<(const Packed &other) const {
+      return weight < other.weight ||
+          (weight == other.weight && id < other.id);
+    }
+  };
+
+  MSTResult result;
+};
+
+inline KruskalMST::KruskalMST(size_t num_vertices,
+                              EdgeSpan edges,
+                              unsigned int num_threads) {
+  std::vector<Packed> order(edges.size());
+  ParallelFor(num_threads, [&](unsigned int t) {
+    size_t end = ChunkBegin(order.size(), t + 1, num_threads);
+    for (size_t i = ChunkBegin(order.size(), t, num_threads); i < end; i++)
+      order[i] = Packed{edges[i].Weight(), static_cast<unsigned int>(i)};
+  });
+  ParallelSort(order.begin(), order.end(), std::less<Packed>(),
+               num_threads);
+
+  // a forest has at most n - 1 edges, so stop once that many are in
+  std::vector<unsigned int> forest;
+  UnionFind components(num_vertices);
+  for (const Packed &p : order) {
+    if (forest.size() + 1 >= num_vertices)
+      break;
+    if (components.Union(edges[p.id].Source(), edges[p.id].Destination()))
+      forest.push_back(p.id);
+  }
+  result = MSTResult(RootForest(num_vertices, edges, forest));
+}
+
+#endif  // KRUSKAL_MST_H_
@@ -0,0 +1,236 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef LAZY_PRIM_MST_H_
+#define LAZY_PRIM_MST_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "graph.h"
+#include "mst.h"
+#include "mst_result.h"
+#include "mst_writer.h"
+#include "prim_key.h"
+
+// PACKED LAZY PQ CLASS
+// Priority queue for Prim's without an indexed heap: a vertex whose key
+// drops is pushed again instead of having its key changed. The heap is a
+// flat array of 64-bit words, each packing a key and a vertex, so that it
+// moves 8 bytes per swap and keeps no positions; it holds up to one word
+// per key change rather than one per vertex.
+//
+// A word is the key's weight bits, mapped to sort like the weight, with
+// the vertex in the low bits in place of the last mantissa bits. The
+// exact key and its word are kept per vertex, and any other word (of an
+// older key, or of a vertex already popped) is stale and skipped. Words
+// equal but for the vertex may hold different exact keys, so all of the
+// heap's lightest such words move to a small heap of exact (key, vertex)
+// entries, which yields the minimum; keys pushed meanwhile with the same
+// truncated weight join it directly. Every word moves there at most once
+// while it is lightest, and the order is exactly that of the keys. A
+// lightest word alone in its truncated weight is the top as it is.
+class PackedLazyPQ {
+ public:
+  // Constructor with max number of indexes
+  explicit PackedLazyPQ(size_t capacity);
+  // Return number of items
+  size_t Size() {
+    return cur_size;
+  }
+  // Return top (ie index associated to minimum key)
+  unsigned int Top();
+  // Remove top
+  void Pop();
+  // Associates @key with index @idx
+  void Push(const PrimKey &key, unsigned int idx);
+  // Return whether @idx is a valid index
+  bool Contains(unsigned int idx) {
+    if (idx >= keys.size())
+      throw std::overflow_error("Index invalid!");
+    return last[idx] != kNone;
+  }
+  // Change key associated to index @idx
+  void ChangeKey(const PrimKey &key, unsigned int idx);
+
+ private:
+  // (exact key, index), ordered as the keys then the indexes
+  typedef std::pair<PrimKey, unsigned int> Entry;
+  // no weight maps to 0: the top bit of every non-negative one's word is
+  // set
+  static constexpr uint64_t kNone = 0;
+
+  std::vector<uint64_t> heap;   // min-heap of words
+  std::vector<uint64_t> last;   // word of the key per index, or kNone
+  std::vector<PrimKey> keys;    // exact key per index
+  std::vector<Entry> tied;      // min-heap of the lightest words' entries
+  uint64_t tied_weight;         // their word without its index bits
+  size_t cur_size;
+  uint64_t index_mask;          // low bits of a word that hold the index
+
+  // Return the word of @weight and @idx
+  uint64_t Pack(double weight, unsigned int idx) const {
+    // -0.0 would sort below +0.0; equal weights must share their bits
+    if (weight == 0)
+      weight = 0;
+    uint64_t bits;
+    std::memcpy(&bits, &weight, sizeof(bits));
+    bits = (bits >> 63) ? ~bits : bits | (uint64_t(1) << 63);
+    return (bits & ~index_mask) | idx;
+  }
+  // Return whether @word is not that of its index's key
+  bool Stale(uint64_t word) {
+    return word != last[word & index_mask];
+  }
+  // Return whether @entry is not its index's key
+  bool Stale(const Entry &entry) {
+    const PrimKey &key = keys[entry.second];
+    return last[entry.second] == kNone || key.weight != entry.first.weight ||
+        key.edge != entry.first.edge;
+  }
+  // Files the key of @idx: among the tied entries if its word ties them,
+  // else as a word
+  void File(unsigned int idx);
+  void PopWord() {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<uint64_t>());
+    heap.pop_back();
+  }
+  void PopTied() {
+    std::pop_heap(tied.begin(), tied.end(), std::greater<Entry>());
+    tied.pop_back();
+  }
+};
+
+inline PackedLazyPQ::PackedLazyPQ(size_t capacity)
+  : last(capacity, kNone), keys(capacity), tied_weight(0), cur_size(0) {
+  // indexes take the low @shift bits of a word
+  unsigned int shift = 1;
+  while (shift < 32 && (uint64_t(1) << shift) < capacity)
+    shift++;
+  index_mask = (uint64_t(1) << shift) - 1;
+}
+
+inline void PackedLazyPQ::File(unsigned int idx) {
+  const uint64_t word = last[idx];
+  if (!tied.empty() && (word & ~index_mask) == tied_weight) {
+    tied.push_back(Entry(keys[idx], idx));
+    std::push_heap(tied.begin(), tied.end(), std::greater<Entry>());
+  } else {
+    heap.push_back(word);
+    std::push_heap(heap.begin(), heap.end(), std::greater<uint64_t>());
+  }
+}
+
+inline unsigned int PackedLazyPQ::Top() {
+  if (!Size())
+    throw std::underflow_error("Priority queue underflow!");
+  while (true) {
+    while (!heap.empty() && Stale(heap.front()))
+      PopWord();
+    while (!tied.empty() && Stale(tied.front()))
+      PopTied();
+    if (tied.empty()) {
+      // every live index has a word or entry, so the heap has one; if no
+      // child shares its truncated weight, no other word does
+      tied_weight = heap.front() & ~index_mask;
+      if ((heap.size() < 2 || (heap[1] & ~index_mask) != tied_weight) &&
+          (heap.size() < 3 || (heap[2] & ~index_mask) != tied_weight))
+        return heap.front() & index_mask;
+      // else take all the words of that weight
+      while (!heap.empty() && (heap.front() & ~index_mask) == tied_weight) {
+        unsigned int idx = heap.front() & index_mask;
+        if (!Stale(heap.front()))
+          tied.push_back(Entry(keys[idx], idx));
+        PopWord();
+      }
+      std::make_heap(tied.begin(), tied.end(), std::greater<Entry>());
+    } else if (!heap.empty() && (heap.front() & ~index_mask) < tied_weight) {
+      // a lighter key came in: the entries go back to words
+      std::vector<Entry> back;
+      back.swap(tied);
+      for (const Entry &entry : back) {
+        if (!Stale(entry))
+          File(entry.second);
+      }
+    } else {
+      return tied.front().second;
+    }
+  }
+}
+
+inline void PackedLazyPQ::Pop() {
+  unsigned int idx = Top();
+  if (tied.empty())
+    PopWord();
+  else
+    PopTied();
+  last[idx] = kNone;
+  // whatever is left is stale
+  if (--cur_size == 0) {
+    heap.clear();
+    tied.clear();
+  }
+}
+
+inline void PackedLazyPQ::Push(const PrimKey &key, unsigned int idx) {
+  if (Contains(idx))
+    throw std::runtime_error("Index already exists!");
+  keys[idx] = key;
+  last[idx] = Pack(key.weight, idx);
+  File(idx);
+  cur_size++;
+}
+
+inline void PackedLazyPQ::ChangeKey(const PrimKey &key, unsigned int idx) {
+  if (!Contains(idx))
+    throw std::runtime_error("Index does not exist!");
+  const uint64_t word = last[idx];
+  keys[idx] = key;
+  last[idx] = Pack(key.weight, idx);
+  // an unchanged word still in the heap stands for the new key too
+  if (last[idx] != word || (!tied.empty() &&
+                            (word & ~index_mask) == tied_weight))
+    File(idx);
+}
+
+// LAZY PRIM MIN SPANNING TREE CLASS
+// Prim's algorithm (GrowPrimTree, as MST runs it) on a PackedLazyPQ, so
+// the forest is MST's, ties included. A comparison engine for the
+// indexed heaps rather than a faster default.
+class LazyPrimMST {
+ public:
+  // computes the minimum spanning forest of @graph
+  explicit LazyPrimMST(const Graph &graph);
+  // return the computed forest
+  const MSTResult &Result() const {
+    return result;
+  }
+  // return the edge that connects each vertex to the tree
+  const std::vector<Edge> &Edges() const {
+    return result.Edges();
+  }
+  // print out the tree edges and total weight
+  void Print(OutputMode mode = OutputMode::kFull) const {
+    PrintMST(result, mode);
+  }
+
+ private:
+  MSTResult result;
+
+  // Return the edge to the tree per vertex
+  static std::vector<Edge> Forest(const Graph &graph);
+};
+
+inline LazyPrimMST::LazyPrimMST(const Graph &graph)
+  : result(Forest(graph)) {}
+
+inline std::vector<Edge> LazyPrimMST::Forest(const Graph &graph) {
+  PackedLazyPQ pqueue(graph.NumVertices());
+  return PrimForest(graph, pqueue);
+}
+
+#endif  // LAZY_PRIM_MST_H_
@@ -0,0 +1,218 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef LINK_CUT_TREE_H_
+#define LINK_CUT_TREE_H_
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// LINK CUT TREE CLASS
+// Forest of weighted nodes under Link and Cut, with the heaviest node on
+// the path between two nodes in O(log n) amortized (Sleator-Tarjan, with
+// splay trees over preferred paths). To keep edge weights, make every
+// edge a node of its own linked between its two endpoints, and give the
+// endpoints weight -infinity.
+class LinkCutTree {
+ public:
+  // Empty node index
+  static constexpr unsigned int kNil = ~0U;
+
+  LinkCutTree() {}
+  // forest of @n single nodes of weight -infinity
+  explicit LinkCutTree(size_t n);
+  // adds a single node of weight @weight, return its index
+  unsigned int AddNode(double weight);
+  // return number of nodes
+  size_t Size() const {
+    return weight.size();
+  }
+  // return weight of node @x
+  double Weight(unsigned int x) const {
+    return weight[x];
+  }
+  // sets weight of node @x
+  void SetWeight(unsigned int x, double w);
+  // return whether @u and @v are in the same tree
+  bool Connected(unsigned int u, unsigned int v);
+  // joins the trees of @u and @v by an edge u-v; they must differ
+  void Link(unsigned int u, unsigned int v);
+  // removes the edge u-v, which must exist
+  void Cut(unsigned int u, unsigned int v);
+  // return heaviest node on the path from @u to @v (same tree), the one
+  // with the lowest index among equals
+  unsigned int PathMax(unsigned int u, unsigned int v);
+
+ private:
+  std::vector<unsigned int> parent;  // splay parent or path parent
+  std::vector<unsigned int> left, right;
+  std::vector<bool> flip;            // children to be swapped below
+  std::vector<double> weight;
+  std::vector<unsigned int> heaviest;  // heaviest node of splay subtree
+  std::vector<unsigned int> path;      // Splay's scratch
+
+  // Return whether @x is the root of its splay tree
+  bool IsSplayRoot(unsigned int x) const {
+    unsigned int p = parent[x];
+    return p == kNil || (left[p] != x && right[p] != x);
+  }
+  // Return whether node @a outweighs node @b
+  bool Heavier(unsigned int a, unsigned int b) const {
+    return weight[a] > weight[b] || (weight[a] == weight[b] && a < b);
+  }
+  // Pushes a pending flip of @x down to its children
+  void Push(unsigned int x);
+  // Recomputes heaviest[x] from its children
+  void Pull(unsigned int x);
+  void Rotate(unsigned int x);
+  // Makes @x the root of its splay tree
+  void Splay(unsigned int x);
+  // Makes the path from the tree root to @x preferred, @x its splay root
+  void Access(unsigned int x);
+  // Makes @x the root of its tree
+  void MakeRoot(unsigned int x);
+  // Return root of the tree holding @x
+  unsigned int FindRoot(unsigned int x);
+};
+
+inline LinkCutTree::LinkCutTree(size_t n) {
+  for (size_t i = 0; i < n; i++)
+    AddNode(-std::numeric_limits<double>::infinity());
+}
+
+inline unsigned int LinkCutTree::AddNode(double w) {
+  unsigned int x = weight.size();
+  parent.push_back(kNil);
+  left.push_back(kNil);
+  right.push_back(kNil);
+  flip.push_back(false);
+  weight.push_back(w);
+  heaviest.push_back(x);
+  return x;
+}
+
+inline void LinkCutTree::Push(unsigned int x) {
+  if (!flip[x])
+    return;
+  std::swap(left[x], right[x]);
+  if (left[x] != kNil)
+    flip[left[x]] = !flip[left[x]];
+  if (right[x] != kNil)
+    flip[right[x]] = !flip[right[x]];
+  flip[x] = false;
+}
+
+inline void LinkCutTree::Pull(unsigned int x) {
+  heaviest[x] = x;
+  if (left[x] != kNil && Heavier(heaviest[left[x]], heaviest[x]))
+    heaviest[x] = heaviest[left[x]];
+  if (right[x] != kNil && Heavier(heaviest[right[x]], heaviest[x]))
+    heaviest[x] = heaviest[right[x]];
+}
+
+inline void LinkCutTree::Rotate(unsigned int x) {
+  unsigned int p = parent[x];
+  unsigned int g = parent[p];
+  if (!IsSplayRoot(p)) {
+    if (left[g] == p)
+      left[g] = x;
+    else
+      right[g] = x;
+  }
+  parent[x] = g;
+  if (left[p] == x) {
+    left[p] = right[x];
+    if (right[x] != kNil)
+      parent[right[x]] = p;
+    right[x] = p;
+  } else {
+    right[p] = left[x];
+    if (left[x] != kNil)
+      parent[left[x]] = p;
+    left[x] = p;
+  }
+  parent[p] = x;
+  Pull(p);
+  Pull(x);
+}
+
+inline void LinkCutTree::Splay(unsigned int x) {
+  // pending flips are pushed top down before any rotation
+  path.assign(1, x);
+  for (unsigned int y = x; !IsSplayRoot(y); y = parent[y])
+    path.push_back(parent[y]);
+  for (size_t i = path.size(); i-- > 0;)
+    Push(path[i]);
+
+  while (!IsSplayRoot(x)) {
+    unsigned int p = parent[x];
+    if (!IsSplayRoot(p)) {
+      unsigned int g = parent[p];
+      // zig-zig rotates the parent first, zig-zag the node twice
+      Rotate((left[g] == p) == (left[p] == x) ? p : x);
+    }
+    Rotate(x);
+  }
+}
+
+inline void LinkCutTree::Access(unsigned int x) {
+  unsigned int last = kNil;
+  for (unsigned int y = x; y != kNil; y = parent[y]) {
+    Splay(y);
+    right[y] = last;
+    Pull(y);
+    last = y;
+  }
+  Splay(x);
+}
+
+inline void LinkCutTree::MakeRoot(unsigned int x) {
+  Access(x);
+  flip[x] = !flip[x];
+}
+
+inline unsigned int LinkCutTree::FindRoot(unsigned int x) {
+  Access(x);
+  Push(x);
+  while (left[x] != kNil) {
+    x = left[x];
+    Push(x);
+  }
+  Splay(x);
+  return x;
+}
+
+inline void LinkCutTree::SetWeight(unsigned int x, double w) {
+  Access(x);
+  weight[x] = w;
+  Pull(x);
+}
+
+inline bool LinkCutTree::Connected(unsigned int u, unsigned int v) {
+  return u == v || FindRoot(u) == FindRoot(v);
+}
+
+inline void LinkCutTree::Link(unsigned int u, unsigned int v) {
+  MakeRoot(u);
+  parent[u] = v;
+}
+
+inline void LinkCutTree::Cut(unsigned int u, unsigned int v) {
+  // with u the root, the path u..v is u, v: v's splay tree holds just u
+  // to the left of v
+  MakeRoot(u);
+  Access(v);
+  Push(v);
+  left[v] = kNil;
+  parent[u] = kNil;
+  Pull(v);
+}
+
+inline unsigned int LinkCutTree::PathMax(unsigned int u, unsigned int v) {
+  MakeRoot(u);
+  Access(v);
+  return heaviest[v];
+}
+
+#endif  // LINK_CUT_TREE_H_
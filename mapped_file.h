@@ -0,0 +1,80 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+// MAPPED FILE CLASS
+// Read-only memory mapping of a whole file
+class MappedFile {
+ public:
+  // maps @path into memory; throws if it cannot be opened
+  explicit MappedFile(const char *path);
+  ~MappedFile();
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  // return first byte of the file
+  const char *Begin() const {
+    return data;
+  }
+  // return one past the last byte of the file
+  const char *End() const {
+    return data + size;
+  }
+  // tells the kernel how the mapping will be read (MADV_SEQUENTIAL, set
+  // when mapped, or MADV_RANDOM, MADV_WILLNEED, ...)
+  void Advise(int advice) const {
+    if (data)
+      madvise(const_cast<char *>(data), size, advice);
+  }
+  // drops the whole pages of [from, to) from memory; they read back from
+  // the file if touched again
+  void Release(const char *from, const char *to) const {
+    const size_t page = sysconf(_SC_PAGESIZE);
+    const size_t first = (from - data + page - 1) / page * page;
+    const size_t last = (to - data) / page * page;
+    if (first < last)
+      madvise(const_cast<char *>(data) + first, last - first, MADV_DONTNEED);
+  }
+
+ private:
+  const char *data;
+  size_t size;
+};
+
+inline MappedFile::MappedFile(const char *path) : data(nullptr), size(0) {
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) < 0) {
+    if (fd >= 0)
+      close(fd);
+    throw std::runtime_error(std::string("Error: cannot open file ") + path);
+  }
+  size = st.st_size;
+  // mmap refuses empty mappings; an empty file is simply an empty range
+  if (size > 0) {
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error(std::string("Error: cannot map file ") + path);
+    }
+    madvise(addr, size, MADV_SEQUENTIAL);
+    data = static_cast<const char *>(addr);
+  }
+  close(fd);
+}
+
+inline MappedFile::~MappedFile() {
+  if (data)
+    munmap(const_cast<char *>(data), size);
+}
+
+#endif  // MAPPED_FILE_H_
@@ -0,0 +1,258 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef MST_H_
+#define MST_H_
+
+#include <cstddef>
+#include <vector>
+#include "graph.h"
+#include "index_array_pq.h"
+#include "index_min_pq.h"
+#include "mst_result.h"
+#include "mst_writer.h"
+#include "pq_counters.h"
+#include "prim_key.h"
+
+// How Prim's algorithm finds the next vertex: from a priority queue in
+// O(E log V), by scanning a distance array in O(V^2 + E), or whichever
+// suits the graph's density E / V^2
+enum class PrimMode { kAuto, kHeap, kDense };
+
+// Density at or above which kAuto scans the array instead of using a
+// heap: only nearly complete graphs (a simple graph has at most V^2 / 2
+// edges). The d2 heap is ahead by a fifth or more up to V^2 / 4 edges,
+// and the scan comes within a few percent of it, weight order aside,
+// only as the graph fills in; see BM_PrimComplete and BM_MSTDensity
+static constexpr double kDensePrimThreshold = 0.45;
+
+// MIN SPANNING TREE CLASS
+// @PQ is the indexed priority queue Prim's algorithm runs on, keyed by
+// PrimKey: among equal weights the edge of least id joins the tree first
+template <typename PQ = IndexMinPQ<PrimKey>>
+class MST {
+ public:
+  // computes the minimum spanning forest of @graph with Prim's algorithm;
+  // the graph is only read, never copied
+  explicit MST(const Graph &graph, PrimMode mode = PrimMode::kAuto);
+  // return the computed forest
+  const MSTResult &Result() const {
+    return result;
+  }
+  // return the edge that connects each vertex to the tree
+  const std::vector<Edge> &Edges() const {
+    return result.Edges();
+  }
+  // return what the run did, if PQ counts (IsCountedPQ), else all zero
+  const MSTCounters &Counters() const {
+    return counters;
+  }
+  // print out the tree edges and total weight
+  void Print(OutputMode mode = OutputMode::kFull) const {
+    PrintMST(result, mode);
+  }
+
+ private:
+  MSTResult result;
+  MSTCounters counters;
+
+  // Return the edge to the tree per vertex, by Prim's with the priority
+  // queue, counting into @counters if PQ counts
+  static std::vector<Edge> HeapPrim(const Graph &graph,
+                                    MSTCounters &counters);
+  // Same, with a vectorized scan for the closest unvisited vertex
+  // (IndexArrayPQ), counting as PQ would
+  static std::vector<Edge> DensePrim(const Graph &graph,
+                                     MSTCounters &counters);
+};
+
+template <typename PQ>
+MST<PQ>::MST(const Graph &graph, PrimMode mode) {
+  double v = graph.NumVertices();
+  if (mode == PrimMode::kAuto)
+    mode = (v > 0 && graph.GetNumEdges() / (v * v) >= kDensePrimThreshold)
+        ? PrimMode::kDense : PrimMode::kHeap;
+  result = MSTResult(mode == PrimMode::kDense ? DensePrim(graph, counters)
+                                             : HeapPrim(graph, counters));
+}
+
+// Scratch slots of the vertices for GrowPrimTree: every vertex is its own
+struct IdentitySlots {
+  // return the slot of vertex @v
+  unsigned int Slot(unsigned int v) const {
+    return v;
+  }
+  // return the vertex of slot @slot
+  unsigned int Vertex(unsigned int slot) const {
+    return slot;
+  }
+};
+
+// Grows Prim's tree from @root over its whole component of @graph, with
+// queue @pqueue (empty) and @dist (PrimKey::Infinity() where unvisited)
+// and @marked indexed by the slot @slots gives each vertex of the
+// component, and @edge by vertex. Vertices are keyed by (weight, edge id)
+// of their lightest edge to the tree, so the tree is the one BoruvkaMST
+// and KruskalMST find. Touches only the vertices of that component, so
+// several components can grow at once into the same @edge array.
+// Adjacency entries for which @accept(arc) is false are skipped, as if
+// their edge were not in the graph. A counting PQ (IsCountedPQ) also
+// counts the entries scanned and those that improved dist[]. G is Graph
+// or any graph with its ForEachArc, ArcEdge and ArcId, such as
+// CompactGraph.
+template <typename G, typename PQ, typename Accept, typename Slots>
+void GrowPrimTree(const G &graph, unsigned int root, PQ &pqueue,
+                  std::vector<PrimKey> &dist, std::vector<bool> &marked,
+                  std::vector<Edge> &edge, Accept accept,
+                  const Slots &slots) {
+  // distance to itself is 0
+  dist[slots.Slot(root)] = PrimKey{0, 0};
+  // for each v search edge list
+  // find smallest edge for that v
+  pqueue.Push(dist[slots.Slot(root)], slots.Slot(root));
+
+  while (pqueue.Size() > 0) {
+    // get destination(vertex) w/ smallest weight
+    unsigned int u = slots.Vertex(pqueue.Top());
+    pqueue.Pop();
+    marked[slots.Slot(u)] = true;
+
+    // all the adjacency entries of the current vertex
+    graph.ForEachArc(u, [&](const auto &arc) {
+      unsigned int v = slots.Slot(arc.vertex);
+      if constexpr (IsCountedPQ<PQ>::value)
+        pqueue.Counters().arcs_scanned++;
+
+      // skip visited vertex and filtered out edges
+      if (marked[v] || !accept(arc)) {
+          return;
+      }
+
+      // new path to reach vertex is shorter than current path
+      // (initially infinity), or as short through an edge of lower id
+      const PrimKey key{arc.weight, graph.ArcId(u, arc)};
+      if (key < dist[v]) {
+        // update distance vector, edge vector, and pqueue
+        if constexpr (IsCountedPQ<PQ>::value)
+          pqueue.Counters().arcs_improved++;
+        dist[v] = key;
+        edge[arc.vertex] = graph.ArcEdge(u, arc);
+        if (pqueue.Contains(v)) {
+          pqueue.ChangeKey(dist[v], v);
+        } else {
+          pqueue.Push(dist[v], v);
+        }
+      }
+    });
+  }
+}
+
+// Same, every vertex its own slot (@pqueue of capacity NumVertices)
+template <typename G, typename PQ, typename Accept>
+void GrowPrimTree(const G &graph, unsigned int root, PQ &pqueue,
+                  std::vector<PrimKey> &dist, std::vector<bool> &marked,
+                  std::vector<Edge> &edge, Accept accept) {
+  GrowPrimTree(graph, root, pqueue, dist, marked, edge, accept,
+               IdentitySlots());
+}
+
+// Same, over every adjacency entry
+template <typename G, typename PQ>
+void GrowPrimTree(const G &graph, unsigned int root, PQ &pqueue,
+                  std::vector<PrimKey> &dist, std::vector<bool> &marked,
+                  std::vector<Edge> &edge) {
+  GrowPrimTree(graph, root, pqueue, dist, marked, edge,
+               [](const auto &) { return true; });
+}
+
+// Return the edge to the tree per vertex of @graph, by Prim's on queue
+// @pqueue (empty, capacity NumVertices), each tree grown from the lowest
+// vertex not yet in a tree
+template <typename G, typename PQ>
+std::vector<Edge> PrimForest(const G &graph, PQ &pqueue) {
+  // dist from src to v
+  std::vector<PrimKey> dist(graph.NumVertices(), PrimKey::Infinity());
+  // has vertex already been visited?
+  std::vector<bool> marked(graph.NumVertices(), false);
+  std::vector<Edge> edge(graph.NumVertices(), Edge(0, 0, 0));
+
+  // for each vertex in the graph
+  for (unsigned int i = 0; i < graph.NumVertices(); i++) {
+    // skip visited vertex
+    if (marked[i]) {
+      continue;
+    }
+    GrowPrimTree(graph, i, pqueue, dist, marked, edge);
+  }
+  return edge;
+}
+
+template <typename PQ>
+std::vector<Edge> MST<PQ>::HeapPrim(const Graph &graph,
+                                    MSTCounters &counters) {
+  // key = weight index = dest_vert
+  PQ pqueue(graph.NumVertices());
+  std::vector<Edge> edge = PrimForest(graph, pqueue);
+  if constexpr (IsCountedPQ<PQ>::value)
+    counters = pqueue.Counters();
+  return edge;
+}
+
+template <typename PQ>
+std::vector<Edge> MST<PQ>::DensePrim(const Graph &graph,
+                                     MSTCounters &counters) {
+  IndexArrayPQ<PrimKey, IsCountedPQ<PQ>::value> pqueue(graph.NumVertices());
+  std::vector<Edge> edge = PrimForest(graph, pqueue);
+  if constexpr (IsCountedPQ<PQ>::value)
+    counters = pqueue.Counters();
+  return edge;
+}
+
+// Return the forest given by edge ids @forest into @edges laid out like
+// MST::Edges(): every tree is rooted at its lowest vertex, as Prim's
+// roots it, and edge[v] links v to its parent (Edge(0, 0, 0) for roots)
+inline std::vector<Edge> RootForest(size_t num_vertices,
+                                    EdgeSpan edges,
+                                    const std::vector<unsigned int> &forest) {
+  const size_t n = num_vertices;
+  // forest adjacency in CSR form: tree edge ids per vertex
+  std::vector<size_t> begin(n + 1, 0);
+  for (unsigned int e : forest) {
+    begin[edges[e].Source() + 1]++;
+    begin[edges[e].Destination() + 1]++;
+  }
+  for (size_t v = 0; v < n; v++)
+    begin[v + 1] += begin[v];
+  std::vector<unsigned int> tree_edges(begin[n]);
+  std::vector<size_t> fill(begin.begin(), begin.end() - 1);
+  for (unsigned int e : forest) {
+    tree_edges[fill[edges[e].Source()]++] = e;
+    tree_edges[fill[edges[e].Destination()]++] = e;
+  }
+
+  // breadth first from the lowest vertex of every tree
+  std::vector<Edge> edge(n, Edge(0, 0, 0));
+  std::vector<bool> marked(n, false);
+  std::vector<unsigned int> queue;
+  queue.reserve(n);
+  for (unsigned int root = 0; root < n; root++) {
+    if (marked[root])
+      continue;
+    marked[root] = true;
+    queue.assign(1, root);
+    for (size_t head = 0; head < queue.size(); head++) {
+      unsigned int u = queue[head];
+      for (size_t i = begin[u]; i < begin[u + 1]; i++) {
+        const Edge &e = edges[tree_edges[i]];
+        unsigned int v = e.Source() == u ? e.Destination() : e.Source();
+        if (marked[v])
+          continue;
+        marked[v] = true;
+        edge[v] = e;
+        queue.push_back(v);
+      }
+    }
+  }
+  return edge;
+}
+
+#endif  // MST_H_
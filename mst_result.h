@@ -0,0 +1,138 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef MST_RESULT_H_
+#define MST_RESULT_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "graph.h"
+
+// MST RESULT CLASS
+// A computed minimum spanning forest, independent of how it was computed
+// and of how it is printed. Every tree is rooted at its lowest vertex;
+// every other vertex v has a parent and the input edge joining the two.
+class MSTResult {
+ public:
+  // Parent of a root
+  static constexpr unsigned int kNoParent = ~0U;
+
+  MSTResult() : total_weight(0), num_components(0) {}
+  // takes the forest laid out like MST::Edges(): @edge[v] joins non-root
+  // v to its parent, roots hold Edge(0, 0, 0)
+  explicit MSTResult(std::vector<Edge> edge);
+
+  // return number of vertices
+  size_t NumVertices() const {
+    return parent.size();
+  }
+  // return whether @v is the root of its tree
+  bool IsRoot(unsigned int v) const {
+    return parent[v] == kNoParent;
+  }
+  // return parent of each vertex, kNoParent for roots
+  const std::vector<unsigned int> &Parents() const {
+    return parent;
+  }
+  // return weight of the edge to each vertex's parent, 0 for roots
+  const std::vector<double> &Weights() const {
+    return weight;
+  }
+  // return the input edge joining each vertex to its parent, as it was
+  // read; Edge(0, 0, 0) for roots
+  const std::vector<Edge> &Edges() const {
+    return edge;
+  }
+  // return sum of the tree edge weights
+  double TotalWeight() const {
+    return total_weight;
+  }
+  // return number of trees, ie connected components of the graph
+  size_t NumComponents() const {
+    return num_components;
+  }
+  // return the tree of each vertex, trees numbered in order of their roots
+  const std::vector<unsigned int> &Components() const {
+    return component;
+  }
+  // return root vertex of each tree
+  const std::vector<unsigned int> &ComponentRoots() const {
+    return component_root;
+  }
+  // return number of vertices of each tree
+  const std::vector<size_t> &ComponentSizes() const {
+    return component_size;
+  }
+  // return total weight of each tree
+  const std::vector<double> &ComponentWeights() const {
+    return component_weight;
+  }
+
+ private:
+  std::vector<Edge> edge;
+  std::vector<unsigned int> parent;
+  std::vector<double> weight;
+  double total_weight;
+  size_t num_components;
+  std::vector<unsigned int> component;
+  std::vector<unsigned int> component_root;
+  std::vector<size_t> component_size;
+  std::vector<double> component_weight;
+
+  // Fills the per-tree members from parent
+  void FindComponents();
+};
+
+inline MSTResult::MSTResult(std::vector<Edge> edge)
+  : edge(std::move(edge)), total_weight(0), num_components(0) {
+  const std::vector<Edge> &tree = this->edge;
+  parent.assign(tree.size(), kNoParent);
+  weight.assign(tree.size(), 0);
+  for (unsigned int v = 0; v < tree.size(); v++) {
+    // a root's placeholder Edge(0, 0, 0) does not touch it (vertex 0 is
+    // always a root)
+    const Edge &e = tree[v];
+    if (v == 0 || (e.Source() != v && e.Destination() != v)) {
+      num_components++;
+      continue;
+    }
+    parent[v] = e.Source() == v ? e.Destination() : e.Source();
+    weight[v] = e.Weight();
+    total_weight += e.Weight();
+  }
+  FindComponents();
+}
+
+inline void MSTResult::FindComponents() {
+  const size_t n = parent.size();
+  component.assign(n, kNoParent);
+  for (unsigned int v = 0; v < n; v++) {
+    if (IsRoot(v)) {
+      component[v] = component_root.size();
+      component_root.push_back(v);
+    }
+  }
+
+  // the tree of a vertex is the tree of its parent: climb to the first
+  // vertex already known, then label the path on the way back
+  std::vector<unsigned int> path;
+  for (unsigned int v = 0; v < n; v++) {
+    unsigned int u = v;
+    while (component[u] == kNoParent) {
+      path.push_back(u);
+      u = parent[u];
+    }
+    for (unsigned int w : path)
+      component[w] = component[u];
+    path.clear();
+  }
+
+  component_size.assign(num_components, 0);
+  component_weight.assign(num_components, 0);
+  for (unsigned int v = 0; v < n; v++) {
+    component_size[component[v]]++;
+    component_weight[component[v]] += weight[v];
+  }
+}
+
+#endif  // MST_RESULT_H_
@@ -0,0 +1,234 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef MST_SERVER_H_
+#define MST_SERVER_H_
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "graph.h"
+#include "index_min_pq.h"
+#include "mst.h"
+#include "mst_result.h"
+#include "mst_writer.h"
+#include "parallel.h"
+#include "prim_key.h"
+
+// One what-if query: the MST of the graph without the edges heavier than
+// @max_weight, the vertices in @skip_vertices (left as single vertex
+// trees) and the edges in @skip_edges, given by their endpoints
+struct MSTQuery {
+  double max_weight = std::numeric_limits<double>::infinity();
+  std::vector<unsigned int> skip_vertices;
+  std::vector<std::pair<unsigned int, unsigned int>> skip_edges;
+  OutputMode mode = OutputMode::kFull;
+};
+
+// Return the query on line @line, of the form
+//   mst [max W] [skip-vertices V,V,...] [skip-edges U-V,U-V,...]
+//       [components | total-only | quiet]
+// with its clauses in any order
+inline MSTQuery ParseQuery(const std::string &line) {
+  std::istringstream in(line);
+  std::string word;
+  if (!(in >> word) || word != "mst")
+    throw std::runtime_error("Unknown command: " + line);
+
+  // unsigned number at the start of @s, which must be followed by @end
+  auto number = [&line](const std::string &s, size_t &pos, char end) {
+    const char *begin = s.c_str() + pos;
+    char *stop;
+    unsigned long v = std::strtoul(begin, &stop, 10);
+    if (stop == begin || *stop != end || v > ~0U)
+      throw std::runtime_error("Bad query: " + line);
+    pos += stop - begin + 1;
+    return static_cast<unsigned int>(v);
+  };
+  MSTQuery query;
+  while (in >> word) {
+    std::string list;
+    if (word == "max") {
+      if (!(in >> query.max_weight))
+        throw std::runtime_error("Bad query: " + line);
+    } else if (word == "skip-vertices" && in >> list) {
+      list += ',';
+      for (size_t pos = 0; pos < list.size();)
+        query.skip_vertices.push_back(number(list, pos, ','));
+    } else if (word == "skip-edges" && in >> list) {
+      list += ',';
+      for (size_t pos = 0; pos < list.size();) {
+        unsigned int u = number(list, pos, '-');
+        query.skip_edges.emplace_back(u, number(list, pos, ','));
+      }
+    } else if (word == "components") {
+      query.mode = OutputMode::kComponents;
+    } else if (word == "total-only") {
+      query.mode = OutputMode::kTotalOnly;
+    } else if (word == "quiet") {
+      query.mode = OutputMode::kQuiet;
+    } else {
+      throw std::runtime_error("Bad query: " + line);
+    }
+  }
+  return query;
+}
+
+// Return the minimum spanning forest of @graph as restricted by @query,
+// computed by Prim's straight over the shared adjacency lists: the
+// excluded vertices and edges are skipped, never copied out
+inline MSTResult FilteredMST(const Graph &graph, const MSTQuery &query) {
+  const size_t n = graph.NumVertices();
+  auto check = [n](unsigned int v) {
+    if (v >= n)
+      throw std::runtime_error("Invalid vertex number " + std::to_string(v));
+  };
+
+  // excluded vertices count as visited, so no tree ever reaches them
+  std::vector<bool> marked(n, false);
+  for (unsigned int v : query.skip_vertices) {
+    check(v);
+    marked[v] = true;
+  }
+  std::vector<unsigned int> skip_ids;
+  for (const auto &ends : query.skip_edges) {
+    check(ends.first);
+    check(ends.second);
+    size_t count = skip_ids.size();
+    for (const Arc &arc : graph.Arcs(ends.first)) {
+      if (arc.vertex == ends.second)
+        skip_ids.push_back(graph.EdgeId(arc.position));
+    }
+    if (skip_ids.size() == count)
+      throw std::runtime_error("No edge " + std::to_string(ends.first) + "-" +
+                               std::to_string(ends.second));
+  }
+  std::sort(skip_ids.begin(), skip_ids.end());
+
+  IndexMinPQ<PrimKey> pqueue(n);
+  std::vector<PrimKey> dist(n, PrimKey::Infinity());
+  std::vector<Edge> edge(n, Edge(0, 0, 0));
+  auto accept = [&](const Arc &arc) {
+    return arc.weight <= query.max_weight &&
+        (skip_ids.empty() ||
+         !std::binary_search(skip_ids.begin(), skip_ids.end(),
+                             graph.EdgeId(arc.position)));
+  };
+  for (unsigned int v = 0; v < n; v++) {
+    if (!marked[v])
+      GrowPrimTree(graph, v, pqueue, dist, marked, edge, accept);
+  }
+  return MSTResult(std::move(edge));
+}
+
+// Return the response to query line @line: the output of FilteredMST as
+// PrintMST would write it, or "error: message", then an empty line
+inline std::string AnswerQuery(const Graph &graph, const std::string &line) {
+  std::string response;
+  try {
+    MSTQuery query = ParseQuery(line);
+    response = FormatMST(FilteredMST(graph, query), query.mode);
+  } catch (const std::runtime_error &e) {
+    response = std::string("error: ") + e.what() + "\n";
+  }
+  return response + "\n";
+}
+
+// MST SERVER CLASS
+// Answers a stream of queries against one graph loaded once. Each query
+// line becomes a task on a pool of threads, all reading the same graph,
+// and the responses go out in the order of the queries.
+class MSTServer {
+ public:
+  // serves queries on @graph, which must outlive the server, on
+  // @num_threads threads
+  MSTServer(const Graph &graph, unsigned int num_threads)
+    : graph(graph), pool(num_threads) {}
+  // answers every query line read from @in_fd on @out_fd, until end of
+  // input; blank lines are skipped
+  void Serve(int in_fd, int out_fd);
+
+ private:
+  const Graph &graph;
+  ThreadPool pool;
+  // responses finished ahead of an earlier one, by query number
+  std::map<size_t, std::string> ready;
+  size_t next_out;  // number of the next response to write
+  bool failed;      // writing to the output failed
+  std::mutex lock;
+
+  // Writes all of @text to @fd, return false on failure
+  static bool WriteAll(int fd, const std::string &text);
+};
+
+inline bool MSTServer::WriteAll(int fd, const std::string &text) {
+  const char *p = text.data();
+  size_t left = text.size();
+  while (left > 0) {
+    ssize_t written = write(fd, p, left);
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    p += written;
+    left -= written;
+  }
+  return true;
+}
+
+inline void MSTServer::Serve(int in_fd, int out_fd) {
+  ready.clear();
+  next_out = 0;
+  failed = false;
+  size_t next_in = 0;
+  auto submit = [&](std::string line) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos)
+      return;
+    size_t number = next_in++;
+    pool.Submit([this, number, out_fd, line] {
+      std::string response = AnswerQuery(graph, line);
+      // whoever completes the response next in line writes it and every
+      // later one already waiting
+      std::lock_guard<std::mutex> guard(lock);
+      ready.emplace(number, std::move(response));
+      std::string out;
+      for (auto it = ready.begin();
+           it != ready.end() && it->first == next_out;
+           it = ready.erase(it), next_out++)
+        out += it->second;
+      if (!failed && !out.empty())
+        failed = !WriteAll(out_fd, out);
+    });
+  };
+
+  std::string pending;
+  char buffer[1 << 16];
+  while (true) {
+    ssize_t got = read(in_fd, buffer, sizeof(buffer));
+    if (got < 0 && errno == EINTR)
+      continue;
+    if (got <= 0)
+      break;
+    pending.append(buffer, got);
+    size_t start = 0;
+    for (size_t end; (end = pending.find('\n', start)) != std::string::npos;
+         start = end + 1)
+      submit(pending.substr(start, end - start));
+    pending.erase(0, start);
+  }
+  submit(pending);
+  pool.Wait();
+}
+
+#endif  // MST_SERVER_H_
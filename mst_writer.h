@@ -0,0 +1,197 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef MST_WRITER_H_
+#define MST_WRITER_H_
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "mst_result.h"
+
+// What PrintMST and FormatMST write: every tree edge and the total weight;
+// the same grouped by tree, each tree headed by "root: N vertices
+// (weight)"; the total weight alone; or nothing (the forest is still
+// computed)
+enum class OutputMode { kFull, kComponents, kTotalOnly, kQuiet };
+
+// MST WRITER CLASS
+// Formats MST output into one large buffer and hands it to the kernel in
+// few write(2) calls, instead of one flushed stream insertion per edge.
+// Vertices print zero-padded to 4 digits and weights with 5 fixed
+// decimals, exactly as iostreams with setw/setfill/fixed would.
+class MSTWriter {
+ public:
+  // writer to file descriptor @fd
+  explicit MSTWriter(int fd = STDOUT_FILENO) : fd(fd), buffer(own) {
+    buffer.reserve(kFlushAt + kMaxLine);
+  }
+  // writer appending to @out in memory, never flushing
+  explicit MSTWriter(std::string *out) : fd(-1), buffer(*out) {}
+  ~MSTWriter() {
+    // errors are reported by an explicit Flush only
+    try {
+      Flush();
+    } catch (const std::runtime_error &) {}
+  }
+  MSTWriter(const MSTWriter &) = delete;
+  MSTWriter &operator=(const MSTWriter &) = delete;
+
+  // appends "ssss-dddd (w.wwwww)\n"
+  void AppendEdge(const Edge &e) {
+    char *p = Reserve();
+    p = Vertex(p, e.Source());
+    *p++ = '-';
+    p = Vertex(p, e.Destination());
+    *p++ = ' ';
+    *p++ = '(';
+    p = Weight(p, e.Weight());
+    *p++ = ')';
+    *p++ = '\n';
+    Commit(p);
+  }
+  // appends "rrrr: N vertices (w.wwwww)\n" ("1 vertex" for one)
+  void AppendTreeHeader(unsigned int root, size_t size, double weight) {
+    char *p = Reserve();
+    p = Vertex(p, root);
+    *p++ = ':';
+    *p++ = ' ';
+    p = std::to_chars(p, p + 20, size).ptr;
+    for (const char *s = size == 1 ? " vertex (" : " vertices ("; *s; s++)
+      *p++ = *s;
+    p = Weight(p, weight);
+    *p++ = ')';
+    *p++ = '\n';
+    Commit(p);
+  }
+  // appends "w.wwwww\n"
+  void AppendTotal(double total) {
+    char *p = Reserve();
+    p = Weight(p, total);
+    *p++ = '\n';
+    Commit(p);
+  }
+  // appends the output of @result selected by @mode: the edge of every
+  // non-root vertex in vertex order, then the total weight
+  void AppendMST(const MSTResult &result, OutputMode mode);
+  // writes out everything buffered so far
+  void Flush();
+
+ private:
+  // longest line: two 10-digit vertices, or a vertex and a 20-digit
+  // count, and a weight of up to 309 + 6 characters, plus punctuation
+  static constexpr size_t kMaxLine = 2 * 20 + 320 + 16;
+  static constexpr size_t kFlushAt = 1 << 20;
+
+  int fd;  // -1 when writing to memory
+  std::string own;
+  std::string &buffer;
+
+  // Return where the next line of at most kMaxLine characters goes
+  char *Reserve() {
+    if (fd >= 0 && buffer.size() >= kFlushAt)
+      Flush();
+    size_t used = buffer.size();
+    buffer.resize(used + kMaxLine);
+    return &buffer[used];
+  }
+  // Trims the buffer to end at @end
+  void Commit(char *end) {
+    buffer.resize(end - buffer.data());
+  }
+  // Writes @v at @p zero-padded to 4 digits, return end
+  static char *Vertex(char *p, unsigned int v) {
+    char digits[10];
+    int n = 0;
+    do {
+      digits[n++] = '0' + v % 10;
+      v /= 10;
+    } while (v);
+    for (int pad = n; pad < 4; pad++)
+      *p++ = '0';
+    while (n)
+      *p++ = digits[--n];
+    return p;
+  }
+  // Writes @w at @p with 5 fixed decimals, return end
+  static char *Weight(char *p, double w) {
+    // to_chars rounds like printf("%.5f") does
+    return std::to_chars(p, p + 320, w, std::chars_format::fixed, 5).ptr;
+  }
+};
+
+inline void MSTWriter::AppendMST(const MSTResult &result, OutputMode mode) {
+  if (mode == OutputMode::kQuiet)
+    return;
+  if (mode == OutputMode::kFull) {
+    for (unsigned int v = 0; v < result.NumVertices(); v++) {
+      if (!result.IsRoot(v))
+        AppendEdge(result.Edges()[v]);
+    }
+  } else if (mode == OutputMode::kComponents) {
+    // vertices grouped by tree, in vertex order inside each tree
+    const std::vector<unsigned int> &component = result.Components();
+    const std::vector<size_t> &size = result.ComponentSizes();
+    std::vector<size_t> begin(result.NumComponents() + 1, 0);
+    for (size_t c = 0; c < size.size(); c++)
+      begin[c + 1] = begin[c] + size[c];
+    std::vector<unsigned int> order(result.NumVertices());
+    std::vector<size_t> fill(begin.begin(), begin.end() - 1);
+    for (unsigned int v = 0; v < result.NumVertices(); v++)
+      order[fill[component[v]]++] = v;
+
+    for (size_t c = 0; c < size.size(); c++) {
+      AppendTreeHeader(result.ComponentRoots()[c], size[c],
+                       result.ComponentWeights()[c]);
+      for (size_t i = begin[c]; i < begin[c + 1]; i++) {
+        if (!result.IsRoot(order[i]))
+          AppendEdge(result.Edges()[order[i]]);
+      }
+    }
+  }
+  AppendTotal(result.TotalWeight());
+}
+
+inline void MSTWriter::Flush() {
+  if (fd < 0)
+    return;
+  const char *p = buffer.data();
+  size_t left = buffer.size();
+  while (left > 0) {
+    ssize_t n = write(fd, p, left);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0) {
+      buffer.clear();
+      throw std::runtime_error("Error: cannot write output");
+    }
+    p += n;
+    left -= n;
+  }
+  // not before: clearing a string overwrites its first byte
+  buffer.clear();
+}
+
+// Prints @result to stdout
+inline void PrintMST(const MSTResult &result,
+                     OutputMode mode = OutputMode::kFull) {
+  MSTWriter out;
+  out.AppendMST(result, mode);
+  out.Flush();
+}
+
+// Return the text PrintMST would print
+inline std::string FormatMST(const MSTResult &result,
+                             OutputMode mode = OutputMode::kFull) {
+  std::string text;
+  MSTWriter out(&text);
+  out.AppendMST(result, mode);
+  return text;
+}
+
+#endif  // MST_WRITER_H_
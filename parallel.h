@@ -0,0 +1,168 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Return number of threads to use when the caller does not say
+inline unsigned int DefaultThreads() {
+  unsigned int n = std::thread::hardware_concurrency();
+  return n ? n : 1;
+}
+
+// Return start of part @t when [0, @n) is split into @parts near-equal
+// contiguous parts (part t is [ChunkBegin(t), ChunkBegin(t + 1)))
+inline size_t ChunkBegin(size_t n, unsigned int t, unsigned int parts) {
+  return n / parts * t + n % parts * t / parts;
+}
+
+// Runs fn(t) for every t in [0, @num_threads), each on its own thread
+// (t = 0 runs on the calling thread), and waits for all of them. If any
+// call throws, the exception of the lowest t is rethrown once all joined.
+template <typename F>
+void ParallelFor(unsigned int num_threads, F fn) {
+  std::vector<std::exception_ptr> errors(num_threads);
+  auto run = [&fn, &errors](unsigned int t) {
+    try {
+      fn(t);
+    } catch (...) {
+      errors[t] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int t = 1; t < num_threads; t++)
+    threads.emplace_back(run, t);
+  run(0);
+  for (std::thread &thread : threads)
+    thread.join();
+
+  for (std::exception_ptr &error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+
+// Runs fn(t, i) for every task i in [0, @num_tasks) on @num_threads
+// threads t; each thread takes the next task as soon as it finishes one,
+// so uneven tasks still keep every thread busy. Tasks start in order.
+template <typename F>
+void ParallelForEach(unsigned int num_threads, size_t num_tasks, F fn) {
+  std::atomic<size_t> next(0);
+  ParallelFor(num_threads, [&](unsigned int t) {
+    for (size_t i = next++; i < num_tasks; i = next++)
+      fn(t, i);
+  });
+}
+
+// Sorts [@first, @last) by @less with @num_threads threads: every thread
+// sorts one contiguous chunk, then neighbouring chunks are merged in
+// pairs, halving the number of runs each round
+template <typename It, typename Less>
+void ParallelSort(It first, It last, Less less, unsigned int num_threads) {
+  const size_t n = last - first;
+  if (num_threads <= 1 || n < 2 * num_threads) {
+    std::sort(first, last, less);
+    return;
+  }
+
+  ParallelFor(num_threads, [&](unsigned int t) {
+    std::sort(first + ChunkBegin(n, t, num_threads),
+              first + ChunkBegin(n, t + 1, num_threads), less);
+  });
+  for (unsigned int width = 1; width < num_threads; width *= 2) {
+    unsigned int merges = (num_threads + 2 * width - 1) / (2 * width);
+    ParallelFor(merges, [&](unsigned int m) {
+      unsigned int lo = 2 * width * m;
+      unsigned int mid = std::min(lo + width, num_threads);
+      unsigned int hi = std::min(lo + 2 * width, num_threads);
+      std::inplace_merge(first + ChunkBegin(n, lo, num_threads),
+                         first + ChunkBegin(n, mid, num_threads),
+                         first + ChunkBegin(n, hi, num_threads), less);
+    });
+  }
+}
+
+// THREAD POOL CLASS
+// Fixed set of worker threads running submitted tasks in submission
+// order, for work that arrives over time; ParallelFor suits work known
+// up front. Tasks must not throw.
+class ThreadPool {
+ public:
+  // starts @num_threads workers
+  explicit ThreadPool(unsigned int num_threads);
+  // runs the tasks still queued, then stops the workers
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  // queues @task to run on a worker
+  void Submit(std::function<void()> task);
+  // waits until every submitted task has finished
+  void Wait();
+
+ private:
+  std::vector<std::thread> workers;
+  std::queue<std::function<void()>> tasks;
+  std::mutex lock;
+  std::condition_variable work;  // signals a task or stopping
+  std::condition_variable idle;  // signals a task finished
+  size_t running;
+  bool stopping;
+};
+
+inline ThreadPool::ThreadPool(unsigned int num_threads)
+  : running(0), stopping(false) {
+  for (unsigned int t = 0; t < num_threads; t++) {
+    workers.emplace_back([this] {
+      std::unique_lock<std::mutex> guard(lock);
+      while (true) {
+        work.wait(guard, [this] { return stopping || !tasks.empty(); });
+        if (tasks.empty())
+          return;
+        std::function<void()> task = std::move(tasks.front());
+        tasks.pop();
+        running++;
+        guard.unlock();
+        task();
+        guard.lock();
+        running--;
+        idle.notify_all();
+      }
+    });
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stopping = true;
+  }
+  work.notify_all();
+  for (std::thread &worker : workers)
+    worker.join();
+}
+
+inline void ThreadPool::Submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    tasks.push(std::move(task));
+  }
+  work.notify_one();
+}
+
+inline void ThreadPool::Wait() {
+  std::unique_lock<std::mutex> guard(lock);
+  idle.wait(guard, [this] { return tasks.empty() && running == 0; });
+}
+
+#endif  // PARALLEL_H_
@@ -0,0 +1,87 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef PERF_COUNTERS_H_
+#define PERF_COUNTERS_H_
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+
+// CACHE COUNTERS CLASS
+// Hardware cache references and misses of the calling thread, user space
+// only, read through perf_event_open(2). Where the kernel forbids it or a
+// virtual machine exposes no hardware counters, Available() is false and
+// both counts stay 0.
+class CacheCounters {
+ public:
+  // opens the counters, stopped
+  CacheCounters()
+    : references(Open(PERF_COUNT_HW_CACHE_REFERENCES)),
+      misses(Open(PERF_COUNT_HW_CACHE_MISSES)) {}
+  ~CacheCounters() {
+    for (int fd : {references, misses}) {
+      if (fd >= 0)
+        close(fd);
+    }
+  }
+  CacheCounters(const CacheCounters &) = delete;
+  CacheCounters &operator=(const CacheCounters &) = delete;
+
+  // return whether the hardware counts
+  bool Available() const {
+    return references >= 0 && misses >= 0;
+  }
+  // zeroes and starts both counters
+  void Start() {
+    for (int fd : {references, misses}) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+  }
+  // stops both counters
+  void Stop() {
+    for (int fd : {references, misses}) {
+      if (fd >= 0)
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  // return cache references counted between Start and Stop
+  uint64_t References() const {
+    return Read(references);
+  }
+  // return cache misses counted between Start and Stop
+  uint64_t Misses() const {
+    return Read(misses);
+  }
+
+ private:
+  int references, misses;  // counter file descriptors, -1 if unavailable
+
+  // Return a stopped counter of hardware event @config, or -1
+  static int Open(uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+  }
+  // Return the count of counter @fd, 0 if unavailable
+  static uint64_t Read(int fd) {
+    uint64_t count = 0;
+    if (fd < 0 || read(fd, &count, sizeof(count)) != sizeof(count))
+      return 0;
+    return count;
+  }
+};
+
+#endif  // PERF_COUNTERS_H_
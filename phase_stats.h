@@ -0,0 +1,117 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef PHASE_STATS_H_
+#define PHASE_STATS_H_
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "pq_counters.h"
+
+// PHASE STATS CLASS
+// Wall time and peak resident set size of each phase of a run, in the
+// order they ended, plus the counters of Prim's priority queue when the
+// run kept them. The peak RSS of a phase is the process's peak when the
+// phase ended, so it never goes down from one phase to the next.
+class PhaseStats {
+ public:
+  // starts timing the first phase
+  PhaseStats() : start(Clock::now()), has_counters(false) {}
+  // ends the current phase as @name and starts the next one
+  void EndPhase(const std::string &name);
+  // records the counters of Prim's run
+  void SetCounters(const MSTCounters &mst_counters) {
+    counters = mst_counters;
+    has_counters = true;
+  }
+  // writes a table of the phases and counters to @out
+  void WriteText(std::ostream &out) const;
+  // writes the phases and counters to @out as one JSON object
+  void WriteJSON(std::ostream &out) const;
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+  struct Phase {
+    std::string name;
+    double seconds;
+    long peak_rss_kib;
+  };
+  Clock::time_point start;  // of the current phase
+  std::vector<Phase> phases;
+  MSTCounters counters;
+  bool has_counters;
+
+  // Return the counters as (name, value) pairs, in declaration order
+  std::vector<std::pair<const char *, uint64_t>> CounterList() const {
+    return {{"push", counters.push},
+            {"pop", counters.pop},
+            {"change_key", counters.change_key},
+            {"percolate_steps", counters.percolate_steps},
+            {"arcs_scanned", counters.arcs_scanned},
+            {"arcs_improved", counters.arcs_improved}};
+  }
+};
+
+inline void PhaseStats::EndPhase(const std::string &name) {
+  Clock::time_point now = Clock::now();
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  // Linux reports kilobytes
+  phases.push_back({name, std::chrono::duration<double>(now - start).count(),
+                    usage.ru_maxrss});
+  start = now;
+}
+
+inline void PhaseStats::WriteText(std::ostream &out) const {
+  double total = 0;
+  out << "phase       seconds  peak RSS KiB\n";
+  for (const Phase &phase : phases) {
+    char line[96];
+    std::snprintf(line, sizeof(line), "%-8s %10.6f %13ld\n",
+                  phase.name.c_str(), phase.seconds, phase.peak_rss_kib);
+    out << line;
+    total += phase.seconds;
+  }
+  char line[96];
+  std::snprintf(line, sizeof(line), "%-8s %10.6f\n", "total", total);
+  out << line;
+  if (!has_counters)
+    return;
+  for (const auto &counter : CounterList())
+    out << counter.first << ": " << counter.second << "\n";
+  if (counters.arcs_scanned > 0)
+    out << "improved / scanned: "
+        << double(counters.arcs_improved) / counters.arcs_scanned << "\n";
+}
+
+inline void PhaseStats::WriteJSON(std::ostream &out) const {
+  double total = 0;
+  out << "{\"phases\": [";
+  for (size_t i = 0; i < phases.size(); i++) {
+    // phase names are plain words, never in need of escapes
+    out << (i ? ", " : "") << "{\"name\": \"" << phases[i].name
+        << "\", \"seconds\": " << phases[i].seconds
+        << ", \"peak_rss_kib\": " << phases[i].peak_rss_kib << "}";
+    total += phases[i].seconds;
+  }
+  out << "], \"total_seconds\": " << total << ", \"counters\": ";
+  if (has_counters) {
+    const char *separator = "{";
+    for (const auto &counter : CounterList()) {
+      out << separator << "\"" << counter.first << "\": " << counter.second;
+      separator = ", ";
+    }
+    out << "}";
+  } else {
+    out << "null";
+  }
+  out << "}\n";
+}
+
+#endif  // PHASE_STATS_H_
@@ -0,0 +1,31 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef PQ_COUNTERS_H_
+#define PQ_COUNTERS_H_
+
+#include <cstdint>
+#include <type_traits>
+
+// What a run of Prim's did: the priority queue operations, the node moves
+// PercolateUp and PercolateDown made, and the adjacency entries scanned
+// against those that lowered dist[] of their vertex. Only queues built
+// with counting on (IndexMinPQ<K, D, InlineKeys, true>, IndexRadixPQ<K,
+// true>) keep them; every other queue compiles without a single increment.
+struct MSTCounters {
+  uint64_t push = 0;
+  uint64_t pop = 0;
+  uint64_t change_key = 0;
+  uint64_t percolate_steps = 0;  // swaps in PercolateUp and PercolateDown
+  uint64_t arcs_scanned = 0;
+  uint64_t arcs_improved = 0;
+};
+
+// Whether priority queue PQ counts into MSTCounters, ie has a kCounted
+// member that is true
+template <typename PQ, typename = void>
+struct IsCountedPQ : std::false_type {};
+
+template <typename PQ>
+struct IsCountedPQ<PQ, std::enable_if_t<PQ::kCounted>> : std::true_type {};
+
+#endif  // PQ_COUNTERS_H_
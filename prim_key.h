@@ -0,0 +1,47 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef PRIM_KEY_H_
+#define PRIM_KEY_H_
+
+#include <limits>
+
+// PRIM KEY STRUCT
+// Priority of a vertex in Prim's algorithm: the weight of its lightest
+// edge to the tree, ties broken by the id of that edge (its position in
+// Graph::Edges()). Prim's then adds edges in the (weight, edge id) order
+// BoruvkaMST and KruskalMST use, and finds the same forest even where
+// weights tie, whatever the priority queue.
+struct PrimKey {
+  double weight;
+  unsigned int edge;
+
+  // return the key of a vertex not reached yet
+  static PrimKey Infinity() {
+    return PrimKey{std::numeric_limits<double>::infinity(), ~0U};
+  }
+};
+
+inline bool operator<(const PrimKey &a, const PrimKey &b) {
+  return a.weight < b.weight || (a.weight == b.weight && a.edge < b.edge);
+}
+inline bool operator>(const PrimKey &a, const PrimKey &b) {
+  return b < a;
+}
+
+// Weight and tie-break of a priority queue key, for the queues that file
+// keys by weight (IndexRadixPQ, IndexArrayPQ): plain numbers have no
+// tie-break, so equal weights are equal keys
+inline double KeyWeight(double key) {
+  return key;
+}
+inline unsigned int KeyTie(double) {
+  return 0;
+}
+inline double KeyWeight(const PrimKey &key) {
+  return key.weight;
+}
+inline unsigned int KeyTie(const PrimKey &key) {
+  return key.edge;
+}
+
+#endif  // PRIM_KEY_H_
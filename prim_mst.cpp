@@ -1,267 +1,569 @@
 // @copyright 2019 Urmi Lalchandani and Shivani Parekh
 
-#include <iostream>
-#include <iomanip>
-#include <fstream>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
 #include <algorithm>
-#include <limits>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
+#include "boruvka_mst.h"
+#include "compact_graph.h"
+#include "ewd_reader.h"
+#include "forest_mst.h"
+#include "graph.h"
+#include "graph_file.h"
+#include "incremental_mst.h"
 #include "index_min_pq.h"
+#include "index_pairing_pq.h"
+#include "index_radix_pq.h"
+#include "kruskal_mst.h"
+#include "lazy_prim_mst.h"
+#include "mst.h"
+#include "mst_server.h"
+#include "parallel.h"
+#include "phase_stats.h"
+#include "prim_key.h"
+#include "reorder.h"
 
-// EDGE CLASS
-class Edge {
- public:
-  // initializes private variables
-  explicit Edge(unsigned int s, unsigned int d, double w);
-  // return source
-  unsigned int Source();
-  // return destination
-  unsigned int Destination();
-  // return weight
-  double Weight();
-
- private:
-  unsigned int source, destination;
-  double weight;
-};
-Edge::Edge(unsigned int s, unsigned int d, double w) {
-  source = s;
-  destination = d;
-  weight = w;
+// Heap allocations so far and their bytes, counted by operator new for
+// --alloc-report once it turns counting on; until then, and without it,
+// an allocation costs one relaxed load more than malloc
+static std::atomic<bool> count_allocations(false);
+static std::atomic<size_t> allocations(0), allocated_bytes(0);
+
+// Return @bytes of memory aligned to @alignment, counted if asked
+static void *CountedAlloc(size_t bytes, size_t alignment) {
+  if (count_allocations.load(std::memory_order_relaxed)) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+  if (!bytes)
+    bytes = 1;
+  void *p = nullptr;
+  if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    p = std::malloc(bytes);
+  else if (posix_memalign(&p, alignment, bytes))
+    p = nullptr;
+  if (!p)
+    throw std::bad_alloc();
+  return p;
 }
-unsigned int Edge::Source() {
-  return source;
+
+void *operator new(size_t bytes) {
+  return CountedAlloc(bytes, 0);
 }
-unsigned int Edge::Destination() {
-  return destination;
+
+void *operator new[](size_t bytes) {
+  return CountedAlloc(bytes, 0);
 }
-double Edge::Weight() {
-  return weight;
+
+void *operator new(size_t bytes, std::align_val_t alignment) {
+  return CountedAlloc(bytes, static_cast<size_t>(alignment));
 }
 
-// VERTEX CLASS
-class Vertex {
- public:
-    // initializes private variables
-    Vertex();
-    // adds an edge to private vector edges
-  void AddEdge(Edge e);
-  // accessor to return vector edges
-  std::vector<Edge> GetEdges();
-  // returns true if the vector edges contains
-  bool ContainsEdge(Edge &e);
-
- private:
-  std::vector<Edge> edges;
-};
-Vertex::Vertex() {}
-void Vertex::AddEdge(Edge e) {
-  edges.push_back(e);
+void *operator new[](size_t bytes, std::align_val_t alignment) {
+  return CountedAlloc(bytes, static_cast<size_t>(alignment));
 }
-std::vector<Edge> Vertex::GetEdges() {
-  return edges;
+
+// malloc and posix_memalign memory alike goes back through free
+void operator delete(void *p) noexcept {
+  std::free(p);
 }
-bool Vertex::ContainsEdge(Edge &e) {
-  bool contains = false;
-  std::vector<Edge> edge_vec = GetEdges();
-  for (auto &ed : edge_vec) {
-    if (ed.Destination() == e.Destination())
-      contains = true;
-  }
-  return contains;
+
+void operator delete[](void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept {
+  std::free(p);
 }
 
-// GRAPH CLASS
-class Graph {
- public:
-    explicit Graph(std::vector<Vertex> v);
-    std::vector<Vertex> Vertices();
-    size_t GetNumEdges();
- private:
-    std::vector<Vertex> vertices;
-};
-Graph::Graph(std::vector<Vertex> v) {
-    vertices = v;
+void operator delete[](void *p, std::align_val_t) noexcept {
+  std::free(p);
 }
-std::vector<Vertex> Graph::Vertices() {
-    return vertices;
+
+void operator delete(void *p, size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void *p, size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+// Prints the allocations made since the last call under @phase
+static void ReportAllocations(const char *phase) {
+  static size_t last_count = 0, last_bytes = 0;
+  size_t count = allocations.load(), bytes = allocated_bytes.load();
+  std::cerr << phase << ": " << count - last_count << " allocations, "
+            << bytes - last_bytes << " bytes" << std::endl;
+  last_count = count;
+  last_bytes = bytes;
+}
+
+// Phase times, peak RSS and Prim's counters for --stats, or null
+static PhaseStats *stats = nullptr;
+
+// Whether binary graph files have their payload checksum verified
+static bool verify_checksum = true;
+
+// Ends the phase @name for --stats
+static void EndPhase(const char *name) {
+  if (stats)
+    stats->EndPhase(name);
 }
-size_t Graph::GetNumEdges() {
-  size_t num_edges = 0;
-  for (auto &v : Vertices()) {
-    num_edges+= v.GetEdges().size();
+
+// Prints how to call the program
+static int Usage(const char *program) {
+  std::cerr << "Usage " << program << " [options] <graph.dat>\n"
+            << "      " << program << " [options] convert <in.txt> <out.bin>\n"
+            << "Options:\n"
+            << "  --threads N  threads used to load a full storage graph and\n"
+            << "               by the boruvka, kruskal and forest engines\n"
+            << "  --engine E   prim (default); boruvka, which runs on all\n"
+            << "               threads; kruskal, which sorts the edges on\n"
+            << "               all threads and needs no adjacency lists;\n"
+            << "               forest, Prim's on every connected component\n"
+            << "               at once; or lazy, Prim's on a plain heap of\n"
+            << "               packed (weight, vertex) words, skipping\n"
+            << "               stale entries instead of changing keys;\n"
+            << "               a comparison engine, not a faster default.\n"
+            << "               Among equal weights the edge listed first\n"
+            << "               wins, so every engine prints the same\n"
+            << "               forest\n"
+            << "  --heap NAME  prim engine only, its priority queue: d2\n"
+            << "               (default), d4, d8, pairing or radix\n"
+            << "  --prim MODE  prim engine only: auto (default), dense on\n"
+            << "               nearly complete graphs only; heap; or\n"
+            << "               dense, to scan an array instead of using a\n"
+            << "               priority queue, O(V^2) whatever the density\n"
+            << "  --order O    relabel the vertices before the prim, boruvka,\n"
+            << "               forest and lazy engines, for cache locality:\n"
+            << "               none (default), bfs, rcm (reverse\n"
+            << "               Cuthill-McKee) or degree; output keeps the\n"
+            << "               input ids\n"
+            << "  --insert F   then insert the edges of EWD file F one by\n"
+            << "               one, updating the tree incrementally\n"
+            << "  --components print the edges tree by tree, each tree after\n"
+            << "               its root, vertex count and weight\n"
+            << "  --total-only print the total weight only\n"
+            << "  --quiet      print nothing, only compute the tree\n"
+            << "  --storage S  prim engine graph storage: full (default);\n"
+            << "               compact, float weights and 4-byte neighbor\n"
+            << "               entries; or delta, float weights and delta\n"
+            << "               encoded neighbors. Totals agree with full\n"
+            << "               storage within 1.2e-7 of the total. Compact\n"
+            << "               storage takes no --heap, --prim or --order\n"
+            << "  --no-checksum\n"
+            << "               skip the payload checksum of binary graph\n"
+            << "               files; the range checks still run\n"
+            << "  --rss        report the peak resident set size on stderr\n"
+            << "  --stats F    report the wall time and peak RSS of every\n"
+            << "               phase and, for the d2, d4, d8 and radix heaps,\n"
+            << "               the priority queue operations and adjacency\n"
+            << "               entries scanned by Prim's, on stderr as\n"
+            << "               text or json\n"
+            << "  --alloc-report\n"
+            << "               report heap allocations and bytes allocated\n"
+            << "               loading the graph and after, on stderr\n"
+            << "  --serve      load the graph, then answer query lines from\n"
+            << "               stdin on all threads, one line each:\n"
+            << "                 mst [max W] [skip-vertices V,V,...]\n"
+            << "                     [skip-edges U-V,U-V,...]\n"
+            << "                     [components | total-only | quiet]\n"
+            << "               each response followed by an empty line\n"
+            << "  --socket P   same, for each client of Unix socket P; a\n"
+            << "               server takes no engine, storage, output,\n"
+            << "               --insert or reporting options\n"
+            << "Options the chosen engine, storage or server would ignore\n"
+            << "are refused."
+            << std::endl;
+  return 1;
+}
+
+// Return the MST of @graph by Prim's on priority queue PQ, handing the
+// counters of a counting PQ to --stats
+template <typename PQ>
+static MSTResult RunPrim(const Graph &graph, PrimMode mode) {
+  MST<PQ> mst(graph, mode);
+  if constexpr (IsCountedPQ<PQ>::value) {
+    if (stats)
+      stats->SetCounters(mst.Counters());
   }
-  return num_edges;
+  return mst.Result();
+}
+
+// Return the MST of @graph by Prim's on a D-ary heap, counting only when
+// --stats asks, so that the plain run keeps the uncounted heap
+template <unsigned int D>
+static MSTResult RunHeapPrim(const Graph &graph, PrimMode mode) {
+  if (stats)
+    return RunPrim<IndexMinPQ<PrimKey, D, false, true>>(graph, mode);
+  return RunPrim<IndexMinPQ<PrimKey, D>>(graph, mode);
 }
 
-// MIN SPANNING TREE CLASS
-class MST {
- public:
-  explicit MST(Graph g);
- private:
-  std::vector<Edge> edge;
-};
-MST::MST(Graph graph) {
-  // key = weight index = dest_vert
-  IndexMinPQ<double> pqueue(graph.GetNumEdges());
-  static const double inf = std::numeric_limits<double>::infinity();
-  std::vector<double> dist;  // dist from src to v
-  std::vector<bool> marked;  // has vertex already been visited?
-
-  // initialize dist marked and edge vectors
-  for (Vertex v : graph.Vertices()) {
-    dist.push_back(inf);
-    marked.push_back(false);
-    Edge e(0, 0, 0);
-    edge.push_back(e);
+// Runs Prim's on the priority queue named @heap into @result, if there is
+// such a queue
+static bool RunPrim(const Graph &graph, const std::string &heap,
+                    PrimMode mode, MSTResult &result) {
+  if (heap == "d2")
+    result = RunHeapPrim<2>(graph, mode);
+  else if (heap == "d4")
+    result = RunHeapPrim<4>(graph, mode);
+  else if (heap == "d8")
+    result = RunHeapPrim<8>(graph, mode);
+  else if (heap == "pairing")
+    result = RunPrim<IndexPairingPQ<PrimKey>>(graph, mode);
+  else if (heap == "radix" && stats)
+    result = RunPrim<IndexRadixPQ<PrimKey, true>>(graph, mode);
+  else if (heap == "radix")
+    result = RunPrim<IndexRadixPQ<PrimKey>>(graph, mode);
+  else
+    return false;
+  return true;
+}
+
+// Parses the EWD text in @file into its distinct edges, return the
+// number of vertices
+static size_t ParseEdgeList(const MappedFile &file, unsigned int threads,
+                            std::vector<Edge> &edges) {
+  // read the header containing the number of vertices
+  EWDReader reader(file.Begin(), file.End());
+
+  // read in edges, checking vertex bounds and weights
+  reader.ParseEdges(edges, threads);
+  EndPhase("parse");
+
+  // EWD files list every edge in both directions
+  DedupEdges(edges);
+  EndPhase("dedup");
+  return reader.NumVertices();
+}
+
+// Parses the EWD text in @file into a graph
+static Graph ParseGraph(const MappedFile &file, unsigned int threads) {
+  std::vector<Edge> edges;
+  size_t num_vertices = ParseEdgeList(file, threads, edges);
+  Graph graph(num_vertices, std::move(edges), threads);
+  EndPhase("build");
+  return graph;
+}
+
+// Return the MST of the graph in @path by Kruskal's, building no
+// adjacency lists for text input
+static MSTResult RunKruskal(const char *path, unsigned int threads) {
+  auto file = std::make_shared<const MappedFile>(path);
+  if (IsGraphFile(file->Begin(), file->End())) {
+    Graph graph = ReadGraphFile(std::move(file), verify_checksum);
+    EndPhase("load");
+    return KruskalMST(graph, threads).Result();
   }
+  std::vector<Edge> edges;
+  size_t num_vertices = ParseEdgeList(*file, threads, edges);
+  return KruskalMST(num_vertices, edges, threads).Result();
+}
 
-  // for each vertex in graph.Vertices()
-  for (unsigned int i = 0; i < graph.Vertices().size(); i++) {
-    // skip visited vertex
-    if (marked[i]) {
-      continue;
-    }
+// Return @result updated with every edge of the EWD file @path, in file
+// order; its vertex count must match
+static MSTResult InsertEdges(const MSTResult &result, const char *path) {
+  MappedFile file(path);
+  EWDReader reader(file.Begin(), file.End());
+  if (reader.NumVertices() != result.NumVertices())
+    throw std::runtime_error(std::string("Error: ") + path + " has " +
+                             std::to_string(reader.NumVertices()) +
+                             " vertices, the graph " +
+                             std::to_string(result.NumVertices()));
+  std::vector<Edge> edges;
+  reader.ParseEdges(edges);
 
-    // distance to itself is 0
-    dist[i] = 0;
-    // for each v search edge list
-    // find smallest edge for that v
-    pqueue.Push(dist[i], i);
-
-    while (pqueue.Size() > 0) {
-      // get destination(vertex) w/ smallest weight
-      unsigned int u = pqueue.Top();
-      pqueue.Pop();
-      marked[u] = true;
-
-      // all the connected edges of the current vertex
-      for (Edge neighbor : graph.Vertices()[u].GetEdges()) {
-        // get the correct adjacent vertex
-        unsigned int v;
-        if (neighbor.Source() == u) {
-            v = neighbor.Destination();
-        }
-        if (neighbor.Destination() == u) {
-            v = neighbor.Source();
-        }
-
-        // skip visited vertex
-        if (marked[v]) {
-            continue;
-        }
-
-        // new path to reach vertex is shorter than current path
-        // (initially infinity)
-        if (neighbor.Weight() < dist[v]) {
-          // update distance vector, edge vector, and pqueue
-          dist[v] = neighbor.Weight();
-          edge[v] = neighbor;
-          if (pqueue.Contains(v)) {
-            pqueue.ChangeKey(dist[v], v);
-          } else {
-            pqueue.Push(dist[v], v);
-          }
-        }
-      }
-    }
+  IncrementalMST forest(result);
+  for (const Edge &e : edges)
+    forest.InsertEdge(e);
+  return forest.Result();
+}
+
+// Loads the graph in @path, binary or EWD text as told by its magic number
+static Graph LoadGraph(const char *path, unsigned int threads) {
+  auto file = std::make_shared<const MappedFile>(path);
+  if (IsGraphFile(file->Begin(), file->End())) {
+    Graph graph = ReadGraphFile(std::move(file), verify_checksum);
+    EndPhase("load");
+    return graph;
   }
+  return ParseGraph(*file, threads);
+}
 
-  // print out minimum spanning tree
-  // special case for empty text file
-  if (edge.size() == 2) {
-      std::cout << "0.00000" << std::endl;
-  } else {
-      double total_weight = 0;
-      for (unsigned int index = 1; index < edge.size(); index++) {
-          Edge e = edge[index];
-          std::cout.precision(5);
-          std::cout << std::setfill('0') << std::setw(4) << e.Source();
-          std::cout << "-";
-          std::cout << std::setfill('0') << std::setw(4) << e.Destination();
-          std::cout << " (" << std::fixed << e.Weight() << ")" << std::endl;
-          total_weight += e.Weight();
-      }
-      std::cout << total_weight << std::endl;
+// Return the minimum spanning forest of the graph in @path stored as a
+// CompactGraph G. G is built straight from the edges of the file, binary
+// or text, parsing the text once per build pass: no edge list is ever
+// stored, and G drops parallel edges itself.
+template <typename G>
+static MSTResult RunCompactPrim(const char *path) {
+  auto file = std::make_shared<const MappedFile>(path);
+  if (IsGraphFile(file->Begin(), file->End())) {
+    Graph full = ReadGraphFile(std::move(file), verify_checksum);
+    EndPhase("load");
+    const EdgeSpan edges = full.Edges();
+    G graph = G::FromStream(full.NumVertices(), [&edges](auto fn) {
+      for (const Edge &e : edges)
+        fn(e);
+    });
+    EndPhase("build");
+    return CompactPrim(graph);
+  }
+  // each pass parses the text a few MB at a time, dropping every piece
+  // from memory once parsed, so the text never adds to the peak
+  const size_t kPiece = size_t(1) << 22;
+  EWDReader reader(file->Begin(), file->End());
+  G graph = G::FromStream(reader.NumVertices(), [&](auto fn) {
+    const char *end = file->End();
+    for (const char *from = reader.Body(); from != end;) {
+      const char *to = std::find(from + std::min<size_t>(kPiece, end - from),
+                                 end, '\n');
+      to = (to == end) ? end : to + 1;
+      reader.ForEachEdge(from, to, fn);
+      file->Release(from, to);
+      from = to;
+    }
+  });
+  file.reset();
+  EndPhase("build");
+  return CompactPrim(graph);
+}
+
+// Answers the queries of every client connecting to the Unix socket at
+// @path, one client at a time, until killed
+static void ServeSocket(MSTServer &server, const char *path) {
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  if (std::strlen(path) >= sizeof(address.sun_path))
+    throw std::runtime_error(std::string("Error: socket path too long: ") +
+                             path);
+  std::strcpy(address.sun_path, path);
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  unlink(path);
+  if (listener < 0 ||
+      bind(listener, reinterpret_cast<sockaddr *>(&address),
+           sizeof(address)) < 0 ||
+      listen(listener, 16) < 0)
+    throw std::runtime_error(std::string("Error: cannot listen on ") + path);
+  // a client leaving early must not kill the server
+  signal(SIGPIPE, SIG_IGN);
+  while (true) {
+    int client = accept(listener, nullptr, nullptr);
+    if (client < 0)
+      continue;
+    server.Serve(client, client);
+    close(client);
   }
 }
 
 // MAIN FUNCTION
 int main(int argc, char *argv[]) {
-  // getting correct number arguments
-  if (argc != 2) {
-    std::cerr << "Usage ./prim_mst <graph.dat>" << std::endl;
-    return 1;
-  }
-  // open file
-  std::ifstream ifs;
-  ifs.open(argv[1]);
-  if (!ifs.is_open()) {
-    std::cerr << "Error: cannot open file " << argv[1] << std::endl;
-    return 1;
-  }
-  
-  // get first line containing the number of vertices
-  // check for valid size
-  std::string line;
-  std::getline(ifs, line);
-  int i = 0;
-  bool invalid = false;
-
-  while (line[i]) {
-    if (isalpha(line[i])) {
-      invalid = true;
+  // getting correct arguments
+  std::vector<const char *> args;
+  unsigned int threads = DefaultThreads();
+  std::string heap = "d2";
+  PrimMode mode = PrimMode::kAuto;
+  std::string engine = "prim";
+  OutputMode output = OutputMode::kFull;
+  const char *insert = nullptr;
+  bool serve = false;
+  const char *socket_path = nullptr;
+  std::string storage = "full";
+  bool rss = false;
+  bool alloc_report = false;
+  VertexOrder order = VertexOrder::kNone;
+  std::string stats_format;
+  // given on the command line, so that options an engine or storage
+  // would ignore are refused instead
+  bool heap_given = false, mode_given = false, order_given = false;
+  bool engine_given = false, storage_given = false, output_given = false;
+  for (int i = 1; i < argc; i++) {
+    if (!std::strcmp(argv[i], "--threads") && i + 1 < argc) {
+      threads = std::strtoul(argv[++i], nullptr, 10);
+      if (threads == 0)
+        return Usage(argv[0]);
+    } else if (!std::strcmp(argv[i], "--heap") && i + 1 < argc) {
+      heap = argv[++i];
+      heap_given = true;
+    } else if (!std::strcmp(argv[i], "--engine") && i + 1 < argc) {
+      engine = argv[++i];
+      engine_given = true;
+      if (engine != "prim" && engine != "boruvka" && engine != "kruskal" &&
+          engine != "forest" && engine != "lazy")
+        return Usage(argv[0]);
+    } else if (!std::strcmp(argv[i], "--prim") && i + 1 < argc) {
+      std::string name = argv[++i];
+      mode_given = true;
+      if (name == "auto")
+        mode = PrimMode::kAuto;
+      else if (name == "heap")
+        mode = PrimMode::kHeap;
+      else if (name == "dense")
+        mode = PrimMode::kDense;
+      else
+        return Usage(argv[0]);
+    } else if (!std::strcmp(argv[i], "--order") && i + 1 < argc) {
+      std::string name = argv[++i];
+      order_given = true;
+      if (name == "none")
+        order = VertexOrder::kNone;
+      else if (name == "bfs")
+        order = VertexOrder::kBFS;
+      else if (name == "rcm")
+        order = VertexOrder::kRCM;
+      else if (name == "degree")
+        order = VertexOrder::kDegree;
+      else
+        return Usage(argv[0]);
+    } else if (!std::strcmp(argv[i], "--insert") && i + 1 < argc) {
+      insert = argv[++i];
+    } else if (!std::strcmp(argv[i], "--components")) {
+      output = OutputMode::kComponents;
+      output_given = true;
+    } else if (!std::strcmp(argv[i], "--total-only")) {
+      output = OutputMode::kTotalOnly;
+      output_given = true;
+    } else if (!std::strcmp(argv[i], "--quiet")) {
+      output = OutputMode::kQuiet;
+      output_given = true;
+    } else if (!std::strcmp(argv[i], "--storage") && i + 1 < argc) {
+      storage = argv[++i];
+      storage_given = true;
+      if (storage != "full" && storage != "compact" && storage != "delta")
+        return Usage(argv[0]);
+    } else if (!std::strcmp(argv[i], "--no-checksum")) {
+      verify_checksum = false;
+    } else if (!std::strcmp(argv[i], "--rss")) {
+      rss = true;
+    } else if (!std::strcmp(argv[i], "--stats") && i + 1 < argc) {
+      stats_format = argv[++i];
+      if (stats_format != "text" && stats_format != "json")
+        return Usage(argv[0]);
+    } else if (!std::strcmp(argv[i], "--alloc-report")) {
+      alloc_report = true;
+      count_allocations.store(true, std::memory_order_relaxed);
+    } else if (!std::strcmp(argv[i], "--serve")) {
+      serve = true;
+    } else if (!std::strcmp(argv[i], "--socket") && i + 1 < argc) {
+      socket_path = argv[++i];
+    } else {
+      args.push_back(argv[i]);
     }
-    i++;
-  }
-  if (invalid) {
-    std::cerr << "Error: invalid graph size " << std::endl;
-    return 1;
-  }
-  // number of vertices
-  size_t capacity = std::stoul(line);
-
-  // vector of empty vertices of size capacity
-  std::vector<Vertex> vertices;
-  for (unsigned int i = 0; i < capacity; ++i) {
-      Vertex v;
-      vertices.push_back(v);
   }
+  bool convert = args.size() == 3 && !std::strcmp(args[0], "convert");
+  if (args.size() != 1 && !convert)
+    return Usage(argv[0]);
+  // compact storage runs Prim's on its own queue in input order; kruskal
+  // needs no adjacency lists to relabel; only prim takes a queue or mode
+  if (storage != "full" &&
+      (engine != "prim" || heap_given || mode_given || order_given))
+    return Usage(argv[0]);
+  if (engine == "kruskal" && order_given)
+    return Usage(argv[0]);
+  if (engine != "prim" && (heap_given || mode_given))
+    return Usage(argv[0]);
+  // a server runs its own Prim's on the full graph and answers each query
+  // in the output mode the query names
+  if ((serve || socket_path) &&
+      (engine_given || heap_given || mode_given || order_given ||
+       storage_given || output_given || !stats_format.empty() || insert ||
+       rss || alloc_report))
+    return Usage(argv[0]);
 
-  // read in vertices
-  unsigned int source, destination;
-  double weight;
-  while (!ifs.eof()) {
-    // read one line to get an edge
-    ifs >> source >> destination >> weight;
-
-    // check for invalid input
-    if (source >= capacity) {
-      std::cerr << "Invalid source vertex number " <<
-        source << std::endl;
-      return 1;
-    }
-    if (destination >= capacity) {
-      std::cerr << "Invalid destination vertex number "
-        << destination << std::endl;
-      return 1;
+  try {
+    if (convert) {
+      // parse the text once and store it for instant loading
+      MappedFile file(args[1]);
+      WriteGraphFile(ParseGraph(file, threads), args[2]);
+      return 0;
     }
-    if (weight < 0) {
-      std::cerr << "Invalid weight " << weight << std::endl;
-      return 1;
+
+    if (serve || socket_path) {
+      // queries share one loaded graph
+      Graph g = LoadGraph(args[0], threads);
+      MSTServer server(g, threads);
+      if (socket_path)
+        ServeSocket(server, socket_path);
+      else
+        server.Serve(STDIN_FILENO, STDOUT_FILENO);
+      return 0;
     }
 
-    Edge e(source, destination, weight);
-    // vertices[source] gives a Vertex*
-    if (!vertices[source].ContainsEdge(e)) {
-      vertices[source].AddEdge(e);
-      vertices[destination].AddEdge(e);
+    PhaseStats phase_stats;
+    if (!stats_format.empty())
+      stats = &phase_stats;
+    MSTResult result;
+    const char *phase = "load and mst";
+    if (engine == "kruskal") {
+      result = RunKruskal(args[0], threads);
+    } else if (storage == "compact") {
+      result = RunCompactPrim<CompactGraph<float, PlainNeighbors>>(args[0]);
+    } else if (storage == "delta") {
+      result = RunCompactPrim<CompactGraph<float, DeltaNeighbors>>(args[0]);
+    } else {
+      Graph g = LoadGraph(args[0], threads);
+      if (alloc_report)
+        ReportAllocations("load");
+      phase = "mst";
+      std::vector<unsigned int> label;
+      if (order != VertexOrder::kNone) {
+        label = VertexLabels(g, order);
+        g = RelabelGraph(g, label, threads);
+        EndPhase("relabel");
+      }
+      if (engine == "boruvka")
+        result = BoruvkaMST(g, threads).Result();
+      else if (engine == "lazy")
+        result = LazyPrimMST(g).Result();
+      else if (engine == "forest")
+        result = ForestMST<>(g, threads).Result();
+      else if (!RunPrim(g, heap, mode, result))
+        return Usage(argv[0]);
+      if (!label.empty())
+        result = UnlabelForest(result, label);
     }
+    EndPhase("mst");
+    if (insert) {
+      result = InsertEdges(result, insert);
+      EndPhase("insert");
+    }
+    PrintMST(result, output);
+    EndPhase("output");
+    if (alloc_report)
+      ReportAllocations(phase);
+    if (rss) {
+      rusage usage;
+      getrusage(RUSAGE_SELF, &usage);
+      // Linux reports kilobytes
+      std::cerr << "peak RSS: " << usage.ru_maxrss << " KiB" << std::endl;
+    }
+    if (stats_format == "text")
+      phase_stats.WriteText(std::cerr);
+    else if (stats_format == "json")
+      phase_stats.WriteJSON(std::cerr);
+  } catch (const std::runtime_error &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
   }
-
-  Graph g(vertices);
-  MST m(g);
-  ifs.close();
   return 0;
 }
@@ -0,0 +1,138 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef REORDER_H_
+#define REORDER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "graph.h"
+#include "mst.h"
+#include "mst_result.h"
+
+// Vertex relabelings that put neighbors at nearby ids, so that Prim's
+// walk over dist, marked and the adjacency lists stays within a few cache
+// lines instead of jumping across the arrays: BFS order; Reverse
+// Cuthill-McKee, BFS from a lowest degree vertex of every component with
+// neighbors taken by increasing degree, reversed; or decreasing degree,
+// which packs the hubs together. Each returns label[v], the new id of v.
+enum class VertexOrder { kNone, kBFS, kRCM, kDegree };
+
+// Return the BFS labels of @graph taking roots from @roots in turn,
+// neighbors of a vertex in adjacency order or, if @by_degree, by
+// increasing degree
+inline std::vector<unsigned int> BFSLabels(
+    const Graph &graph, const std::vector<unsigned int> &roots,
+    bool by_degree) {
+  const size_t n = graph.NumVertices();
+  auto degree = [&graph](unsigned int v) {
+    return graph.End(v) - graph.Begin(v);
+  };
+  std::vector<unsigned int> order;  // vertices in visiting order
+  order.reserve(n);
+  std::vector<bool> marked(n, false);
+  for (unsigned int root : roots) {
+    if (marked[root])
+      continue;
+    marked[root] = true;
+    order.push_back(root);
+    for (size_t head = order.size() - 1; head < order.size(); head++) {
+      size_t first = order.size();
+      for (const Arc &arc : graph.Arcs(order[head])) {
+        if (!marked[arc.vertex]) {
+          marked[arc.vertex] = true;
+          order.push_back(arc.vertex);
+        }
+      }
+      if (by_degree)
+        std::stable_sort(order.begin() + first, order.end(),
+                         [&degree](unsigned int a, unsigned int b) {
+                           return degree(a) < degree(b);
+                         });
+    }
+  }
+  std::vector<unsigned int> label(n);
+  for (size_t i = 0; i < n; i++)
+    label[order[i]] = i;
+  return label;
+}
+
+// Return labels of @graph's vertices in the given @order
+inline std::vector<unsigned int> VertexLabels(const Graph &graph,
+                                              VertexOrder order) {
+  const size_t n = graph.NumVertices();
+  std::vector<unsigned int> vertices(n);
+  for (unsigned int v = 0; v < n; v++)
+    vertices[v] = v;
+  auto degree = [&graph](unsigned int v) {
+    return graph.End(v) - graph.Begin(v);
+  };
+
+  switch (order) {
+    case VertexOrder::kBFS:
+      return BFSLabels(graph, vertices, false);
+    case VertexOrder::kRCM: {
+      // the first vertex of a component in degree order has its lowest
+      // degree
+      std::stable_sort(vertices.begin(), vertices.end(),
+                       [&degree](unsigned int a, unsigned int b) {
+                         return degree(a) < degree(b);
+                       });
+      std::vector<unsigned int> label = BFSLabels(graph, vertices, true);
+      for (unsigned int &l : label)
+        l = n - 1 - l;
+      return label;
+    }
+    case VertexOrder::kDegree: {
+      std::stable_sort(vertices.begin(), vertices.end(),
+                       [&degree](unsigned int a, unsigned int b) {
+                         return degree(a) > degree(b);
+                       });
+      std::vector<unsigned int> label(n);
+      for (size_t i = 0; i < n; i++)
+        label[vertices[i]] = i;
+      return label;
+    }
+    default:
+      return vertices;
+  }
+}
+
+// Return @graph with every vertex v renamed @label[v]; edges keep their
+// ids and orientation
+inline Graph RelabelGraph(const Graph &graph,
+                          const std::vector<unsigned int> &label,
+                          unsigned int num_threads = 1) {
+  std::vector<Edge> edges;
+  edges.reserve(graph.GetNumEdges());
+  for (const Edge &e : graph.Edges())
+    edges.push_back(Edge(label[e.Source()], label[e.Destination()],
+                         e.Weight()));
+  return Graph(graph.NumVertices(), std::move(edges), num_threads);
+}
+
+// Return the forest @result of a graph relabeled by @label, in the
+// original ids and laid out as MST lays it out
+inline MSTResult UnlabelForest(const MSTResult &result,
+                               const std::vector<unsigned int> &label) {
+  const size_t n = result.NumVertices();
+  std::vector<unsigned int> vertex(n);  // original id of each label
+  for (unsigned int v = 0; v < n; v++)
+    vertex[label[v]] = v;
+
+  std::vector<Edge> tree;
+  for (unsigned int v = 0; v < n; v++) {
+    if (result.IsRoot(v))
+      continue;
+    const Edge &e = result.Edges()[v];
+    tree.push_back(Edge(vertex[e.Source()], vertex[e.Destination()],
+                        e.Weight()));
+  }
+  std::vector<unsigned int> ids(tree.size());
+  for (unsigned int i = 0; i < ids.size(); i++)
+    ids[i] = i;
+  return MSTResult(RootForest(n, tree, ids));
+}
+
+#endif  // REORDER_H_
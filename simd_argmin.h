@@ -0,0 +1,148 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef SIMD_ARGMIN_H_
+#define SIMD_ARGMIN_H_
+
+#include <cstddef>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// Return position of the first smallest value of @values[0, @n), or 0 if
+// n == 0, and set @tied, if given, to whether that value occurs again.
+// Uses AVX2 when the CPU has it, SSE2 otherwise (x86-64), plain C++
+// elsewhere; every version returns the same position.
+size_t ArgMin(const double *values, size_t n, bool *tied = nullptr);
+
+// Plain version
+inline size_t ArgMinScalar(const double *values, size_t n, bool *tied) {
+  size_t best = 0;
+  bool again = false;
+  for (size_t i = 1; i < n; i++) {
+    if (values[i] < values[best]) {
+      best = i;
+      again = false;
+    } else if (values[i] == values[best]) {
+      again = true;
+    }
+  }
+  if (tied)
+    *tied = again;
+  return best;
+}
+
+#if defined(__x86_64__)
+// Both vector versions keep, per lane, the smallest value seen, its
+// position (updated on strictly smaller values only, so each lane keeps
+// its first minimum) and whether it was seen again, then reduce the lanes
+// by value and position; the minimum is tied if its lane saw it again or
+// another lane holds it too. The lanes start at infinity, so each holds
+// one of its own values, and the plain loop finishes the tail.
+inline size_t ArgMinReduce(const double *lane, const double *lane_at,
+                           const double *lane_again, int lanes,
+                           const double *values, size_t i, size_t n,
+                           bool *tied) {
+  size_t pos = 0;
+  bool again = false;
+  if (i == 0) {
+    // no full vector: the plain loop takes it all
+    i = 1;
+  } else {
+    int k = 0;
+    for (int j = 1; j < lanes; j++) {
+      if (lane[j] < lane[k] || (lane[j] == lane[k] && lane_at[j] < lane_at[k]))
+        k = j;
+    }
+    pos = lane_at[k];
+    for (int j = 0; j < lanes; j++) {
+      if (lane[j] == lane[k] && (j != k || lane_again[j] != 0))
+        again = true;
+    }
+  }
+  for (; i < n; i++) {
+    if (values[i] < values[pos]) {
+      pos = i;
+      again = false;
+    } else if (values[i] == values[pos]) {
+      again = true;
+    }
+  }
+  if (tied)
+    *tied = again;
+  return pos;
+}
+
+inline size_t ArgMinSSE2(const double *values, size_t n, bool *tied) {
+  size_t i = 0;
+  __m128d best = _mm_set1_pd(__builtin_inf());
+  __m128d best_at = _mm_setzero_pd();
+  __m128d again = _mm_setzero_pd();
+  __m128d at = _mm_set_pd(1, 0);
+  const __m128d step = _mm_set1_pd(2);
+  for (; i + 2 <= n; i += 2) {
+    __m128d v = _mm_loadu_pd(values + i);
+    __m128d lt = _mm_cmplt_pd(v, best);
+    __m128d eq = _mm_cmpeq_pd(v, best);
+    best = _mm_or_pd(_mm_and_pd(lt, v), _mm_andnot_pd(lt, best));
+    best_at = _mm_or_pd(_mm_and_pd(lt, at), _mm_andnot_pd(lt, best_at));
+    again = _mm_or_pd(_mm_andnot_pd(lt, again), eq);
+    at = _mm_add_pd(at, step);
+  }
+  double lane[2], lane_at[2], lane_again[2];
+  _mm_storeu_pd(lane, best);
+  _mm_storeu_pd(lane_at, best_at);
+  _mm_storeu_pd(lane_again, again);
+  return ArgMinReduce(lane, lane_at, lane_again, 2, values, i, n, tied);
+}
+
+__attribute__((target("avx2")))
+inline size_t ArgMinAVX2(const double *values, size_t n, bool *tied) {
+  // four independent accumulators hide the compare/blend latency
+  const int kAcc = 4;
+  size_t i = 0;
+  __m256d best[kAcc], best_at[kAcc], again[kAcc], at[kAcc];
+  for (int a = 0; a < kAcc; a++) {
+    best[a] = _mm256_set1_pd(__builtin_inf());
+    best_at[a] = _mm256_setzero_pd();
+    again[a] = _mm256_setzero_pd();
+    at[a] = _mm256_set_pd(4 * a + 3, 4 * a + 2, 4 * a + 1, 4 * a);
+  }
+  const __m256d step = _mm256_set1_pd(4 * kAcc);
+  for (; i + 4 * kAcc <= n; i += 4 * kAcc) {
+    for (int a = 0; a < kAcc; a++) {
+      __m256d v = _mm256_loadu_pd(values + i + 4 * a);
+      __m256d lt = _mm256_cmp_pd(v, best[a], _CMP_LT_OQ);
+      __m256d eq = _mm256_cmp_pd(v, best[a], _CMP_EQ_OQ);
+      best[a] = _mm256_blendv_pd(best[a], v, lt);
+      best_at[a] = _mm256_blendv_pd(best_at[a], at[a], lt);
+      again[a] = _mm256_or_pd(_mm256_andnot_pd(lt, again[a]), eq);
+      at[a] = _mm256_add_pd(at[a], step);
+    }
+  }
+
+  double lane[4 * kAcc], lane_at[4 * kAcc], lane_again[4 * kAcc];
+  for (int a = 0; a < kAcc; a++) {
+    _mm256_storeu_pd(lane + 4 * a, best[a]);
+    _mm256_storeu_pd(lane_at + 4 * a, best_at[a]);
+    _mm256_storeu_pd(lane_again + 4 * a, again[a]);
+  }
+  return ArgMinReduce(lane, lane_at, lane_again, 4 * kAcc, values, i, n,
+                      tied);
+}
+#endif
+
+inline size_t ArgMin(const double *values, size_t n, bool *tied) {
+  if (n == 0) {
+    if (tied)
+      *tied = false;
+    return 0;
+  }
+#if defined(__x86_64__)
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  return avx2 ? ArgMinAVX2(values, n, tied) : ArgMinSSE2(values, n, tied);
+#else
+  return ArgMinScalar(values, n, tied);
+#endif
+}
+
+#endif  // SIMD_ARGMIN_H_
@@ -0,0 +1,107 @@
+// @copyright 2019 Shivani Parekh and Urmi Lalchandani
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "compact_graph.h"
+#include "ewd_reader.h"
+#include "graph.h"
+#include "mst.h"
+#include "mst_result.h"
+
+// Edges of a bundled EWD file as read, duplicates included
+static std::vector<Edge> ReadEdges(const char *path, size_t &num_vertices) {
+  MappedFile file(path);
+  EWDReader reader(file.Begin(), file.End());
+  std::vector<Edge> edges;
+  reader.ParseEdges(edges);
+  num_vertices = reader.NumVertices();
+  return edges;
+}
+
+// Expects @forest to weigh what @expected weighs within the float
+// tolerance documented in compact_graph.h, with as many trees
+static void ExpectWithinTolerance(const MSTResult &forest,
+                                  const MSTResult &expected) {
+  EXPECT_NEAR(forest.TotalWeight(), expected.TotalWeight(),
+              expected.TotalWeight() * 0x1p-23 + 1e-12);
+  EXPECT_EQ(forest.NumComponents(), expected.NumComponents());
+}
+
+class CompactGraphFileTest : public ::testing::TestWithParam<const char *> {};
+
+TEST_P(CompactGraphFileTest, TotalsMatchFullStorage) {
+  size_t n;
+  std::vector<Edge> edges = ReadEdges(GetParam(), n);
+  std::vector<Edge> distinct = edges;
+  DedupEdges(distinct);
+  MSTResult expected = MST<>(Graph(n, std::move(distinct))).Result();
+
+  CompactGraph<float, PlainNeighbors> plain(n, edges);
+  ExpectWithinTolerance(CompactPrim(plain), expected);
+  CompactGraph<float, DeltaNeighbors> delta(n, edges);
+  ExpectWithinTolerance(CompactPrim(delta), expected);
+  EXPECT_EQ(plain.GetNumEdges(), delta.GetNumEdges());
+  // the gaps pay for the per-vertex byte offsets from a few entries on
+  if (plain.GetNumEdges() >= 4 * n) {
+    EXPECT_LT(delta.Bytes(), plain.Bytes());
+  }
+}
+
+// Built straight from the text, twice parsed, the graph is the one built
+// from the edge list
+TEST_P(CompactGraphFileTest, StreamBuildMatchesEdgeList) {
+  size_t n;
+  std::vector<Edge> edges = ReadEdges(GetParam(), n);
+  MappedFile file(GetParam());
+  EWDReader reader(file.Begin(), file.End());
+  auto streamed = CompactGraph<float, DeltaNeighbors>::FromStream(
+      n, [&reader](auto fn) { reader.ForEachEdge(fn); });
+  CompactGraph<float, DeltaNeighbors> listed(n, edges);
+  EXPECT_EQ(streamed.Bytes(), listed.Bytes());
+  MSTResult a = CompactPrim(streamed), b = CompactPrim(listed);
+  ASSERT_EQ(a.Edges().size(), b.Edges().size());
+  for (size_t v = 0; v < a.Edges().size(); v++) {
+    EXPECT_EQ(a.Edges()[v].Source(), b.Edges()[v].Source());
+    EXPECT_EQ(a.Edges()[v].Destination(), b.Edges()[v].Destination());
+    EXPECT_EQ(a.Edges()[v].Weight(), b.Edges()[v].Weight());
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(BundledEWD, CompactGraphFileTest,
+                         ::testing::Values("tinyEWD.txt", "mediumEWD.txt",
+                                           "1000EWD.txt", "10000EWD.txt",
+                                           "emptyEWD.txt", "oneEWD.txt"));
+
+// Parallel edges keep their lightest copy, in its input orientation, and
+// self-loops go
+TEST(CompactGraphTest, DropsParallelEdgesAndLoops) {
+  std::vector<Edge> edges{Edge(0, 1, 3.0), Edge(2, 2, 0.5), Edge(1, 0, 1.0),
+                          Edge(1, 2, 2.0), Edge(0, 1, 1.0), Edge(2, 1, 4.0)};
+  CompactGraph<double, DeltaNeighbors> graph(3, edges);
+  EXPECT_EQ(graph.GetNumEdges(), 2);
+
+  MSTResult forest = CompactPrim(graph);
+  EXPECT_DOUBLE_EQ(forest.TotalWeight(), 3.0);
+  EXPECT_EQ(forest.Edges()[1].Source(), 1);
+  EXPECT_EQ(forest.Edges()[2].Source(), 1);
+}
+
+TEST(CompactGraphTest, RefusesWeightsFloatCannotHold) {
+  // 1e39 is finite as a double but rounds to infinity as a float, which
+  // Prim's would take for no edge
+  std::vector<Edge> edges{Edge(0, 1, 1.0), Edge(1, 2, 1e39)};
+  EXPECT_THROW(CompactGraph<>(3, edges), std::runtime_error);
+  EXPECT_THROW(CompactGraph<>::FromStream(3, [&edges](auto fn) {
+                 for (const Edge &e : edges)
+                   fn(e);
+               }),
+               std::runtime_error);
+  EXPECT_EQ(CompactGraph<double>(3, edges).GetNumEdges(), 2);
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,226 @@
+// @copyright 2019 Shivani Parekh and Urmi Lalchandani
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "dynamic_mst.h"
+#include "ewd_reader.h"
+#include "graph.h"
+#include "incremental_mst.h"
+#include "kruskal_mst.h"
+#include "mst_result.h"
+
+// Distinct edges of a bundled EWD file, in random order
+static std::vector<Edge> ShuffledEdges(const char *path, size_t &num_vertices,
+                                       unsigned int seed) {
+  MappedFile file(path);
+  EWDReader reader(file.Begin(), file.End());
+  std::vector<Edge> edges;
+  reader.ParseEdges(edges);
+  DedupEdges(edges);
+  std::mt19937 gen(seed);
+  std::shuffle(edges.begin(), edges.end(), gen);
+  num_vertices = reader.NumVertices();
+  return edges;
+}
+
+// Forest of @num_vertices vertices and no edges
+static MSTResult EmptyForest(size_t num_vertices) {
+  return MSTResult(std::vector<Edge>(num_vertices, Edge(0, 0, 0)));
+}
+
+// Expects @forest to be a spanning forest of the first @count @edges with
+// the weight of a minimum one
+static void ExpectMinimum(const MSTResult &forest, EdgeSpan edges,
+                          size_t count) {
+  std::vector<Edge> prefix(edges.begin(), edges.begin() + count);
+  MSTResult expected = KruskalMST(forest.NumVertices(), prefix).Result();
+  EXPECT_NEAR(forest.TotalWeight(), expected.TotalWeight(), 1e-9);
+  EXPECT_EQ(forest.NumComponents(), expected.NumComponents());
+  for (unsigned int v = 0; v < forest.NumVertices(); v++) {
+    if (forest.IsRoot(v))
+      continue;
+    const Edge &e = forest.Edges()[v];
+    EXPECT_TRUE(e.Source() == v || e.Destination() == v);
+  }
+}
+
+class IncrementalMSTFileTest
+    : public ::testing::TestWithParam<const char *> {};
+
+// Inserting a file's edges in random order keeps a minimum spanning forest
+// at every checkpoint, and ends at the forest of the whole file
+TEST_P(IncrementalMSTFileTest, RandomInsertionsMatchRecompute) {
+  for (unsigned int seed = 1; seed <= 3; seed++) {
+    size_t n;
+    std::vector<Edge> edges = ShuffledEdges(GetParam(), n, seed);
+    IncrementalMST mst(EmptyForest(n));
+
+    // about 20 checkpoints, every insertion on small files
+    size_t step = std::max<size_t>(1, edges.size() / 20);
+    for (size_t i = 0; i < edges.size(); i++) {
+      mst.InsertEdge(edges[i]);
+      if ((i + 1) % step == 0 || i + 1 == edges.size()) {
+        MSTResult forest = mst.Result();
+        ExpectMinimum(forest, edges, i + 1);
+        EXPECT_NEAR(mst.TotalWeight(), forest.TotalWeight(), 1e-9);
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(BundledEWD, IncrementalMSTFileTest,
+                         ::testing::Values("tinyEWD.txt", "mediumEWD.txt",
+                                           "1000EWD.txt", "10000EWD.txt"));
+
+// Starting from a computed tree and inserting the rest of the edges gives
+// the tree of the whole graph
+TEST(IncrementalMSTTest, InsertIntoComputedTree) {
+  size_t n;
+  std::vector<Edge> edges = ShuffledEdges("mediumEWD.txt", n, 7);
+  size_t half = edges.size() / 2;
+  std::vector<Edge> first(edges.begin(), edges.begin() + half);
+  IncrementalMST mst(KruskalMST(n, first).Result());
+  for (size_t i = half; i < edges.size(); i++)
+    mst.InsertEdge(edges[i]);
+  ExpectMinimum(mst.Result(), edges, edges.size());
+}
+
+// Small graphs with few distinct weights, so that many edges tie
+TEST(IncrementalMSTTest, RandomTiedWeights) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<unsigned int> vertex(0, 29);
+  std::uniform_int_distribution<int> weight(1, 4);
+  for (int round = 0; round < 20; round++) {
+    std::vector<Edge> edges;
+    IncrementalMST mst(EmptyForest(30));
+    for (int i = 0; i < 120; i++) {
+      edges.push_back(Edge(vertex(gen), vertex(gen), weight(gen)));
+      mst.InsertEdge(edges.back());
+      ExpectMinimum(mst.Result(), edges, edges.size());
+    }
+  }
+}
+
+TEST(IncrementalMSTTest, InsertReportsChanges) {
+  IncrementalMST mst(EmptyForest(3));
+  EXPECT_TRUE(mst.InsertEdge(Edge(0, 1, 2.0)));
+  EXPECT_TRUE(mst.InsertEdge(Edge(1, 2, 3.0)));
+  // heavier than every edge of the path 0-1-2
+  EXPECT_FALSE(mst.InsertEdge(Edge(0, 2, 4.0)));
+  // replaces 1-2
+  EXPECT_TRUE(mst.InsertEdge(Edge(2, 0, 1.0)));
+  EXPECT_DOUBLE_EQ(mst.TotalWeight(), 3.0);
+  EXPECT_FALSE(mst.InsertEdge(Edge(1, 1, 0.5)));
+  EXPECT_THROW(mst.InsertEdge(Edge(0, 3, 1.0)), std::runtime_error);
+
+  MSTResult forest = mst.Result();
+  EXPECT_EQ(forest.Parents()[1], 0);
+  EXPECT_EQ(forest.Parents()[2], 0);
+  EXPECT_EQ(forest.NumComponents(), 1);
+}
+
+// Loads a bundled EWD file the way prim_mst does
+static Graph LoadGraph(const char *path) {
+  MappedFile file(path);
+  EWDReader reader(file.Begin(), file.End());
+  std::vector<Edge> edges;
+  reader.ParseEdges(edges);
+  DedupEdges(edges);
+  return Graph(reader.NumVertices(), std::move(edges));
+}
+
+class DynamicMSTFileTest : public ::testing::TestWithParam<const char *> {};
+
+// Random mixes of deletions, weight changes and insertions keep a minimum
+// spanning forest of the edges left
+TEST_P(DynamicMSTFileTest, MixedUpdatesMatchRecompute) {
+  Graph graph = LoadGraph(GetParam());
+  DynamicMST mst(graph);
+  ExpectMinimum(mst.Result(), graph.Edges(), graph.GetNumEdges());
+
+  std::vector<Edge> edges(graph.Edges().begin(), graph.Edges().end());
+  std::vector<bool> alive(edges.size(), true);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<unsigned int> vertex(0,
+                                                     graph.NumVertices() - 1);
+  std::uniform_real_distribution<double> weight(0.0, 1.0);
+  const int kUpdates = 600;
+  for (int i = 0; i < kUpdates; i++) {
+    unsigned int id = gen() % edges.size();
+    switch (gen() % 3) {
+      case 0:
+        if (alive[id]) {
+          mst.DeleteEdge(id);
+          alive[id] = false;
+        }
+        break;
+      case 1:
+        if (alive[id]) {
+          // tree edges often, so that both directions are exercised
+          double w = (gen() % 2) ? weight(gen) : edges[id].Weight() * 2;
+          mst.UpdateWeight(id, w);
+          edges[id] = Edge(edges[id].Source(), edges[id].Destination(), w);
+        }
+        break;
+      default:
+        edges.push_back(Edge(vertex(gen), vertex(gen), weight(gen)));
+        alive.push_back(true);
+        EXPECT_EQ(mst.AddEdge(edges.back()), edges.size() - 1);
+    }
+
+    if ((i + 1) % 50 == 0) {
+      std::vector<Edge> left;
+      for (size_t e = 0; e < edges.size(); e++) {
+        EXPECT_EQ(mst.Contains(e), alive[e]);
+        if (alive[e])
+          left.push_back(edges[e]);
+      }
+      MSTResult forest = mst.Result();
+      ExpectMinimum(forest, left, left.size());
+      EXPECT_NEAR(mst.TotalWeight(), forest.TotalWeight(), 1e-9);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(BundledEWD, DynamicMSTFileTest,
+                         ::testing::Values("tinyEWD.txt", "mediumEWD.txt",
+                                           "1000EWD.txt"));
+
+// Deleting tree edges until the graph falls apart, then reconnecting
+TEST(DynamicMSTTest, DeleteAndReplace) {
+  std::vector<Edge> edges{Edge(0, 1, 1.0), Edge(1, 2, 2.0), Edge(0, 2, 3.0),
+                          Edge(2, 3, 1.5)};
+  DynamicMST mst(Graph(4, edges));
+  EXPECT_DOUBLE_EQ(mst.TotalWeight(), 4.5);
+  EXPECT_FALSE(mst.InTree(2));
+
+  // 0-2 replaces 1-2
+  mst.DeleteEdge(1);
+  EXPECT_TRUE(mst.InTree(2));
+  EXPECT_DOUBLE_EQ(mst.TotalWeight(), 5.5);
+  // no replacement for 2-3: two trees
+  mst.DeleteEdge(3);
+  EXPECT_EQ(mst.Result().NumComponents(), 2);
+  EXPECT_THROW(mst.DeleteEdge(3), std::runtime_error);
+
+  // heavier 0-2 stays, as the only edge across its cut
+  mst.UpdateWeight(2, 10.0);
+  EXPECT_TRUE(mst.InTree(2));
+  // a lighter path appears and displaces it
+  unsigned int id = mst.AddEdge(Edge(1, 2, 0.5));
+  EXPECT_TRUE(mst.InTree(id));
+  EXPECT_FALSE(mst.InTree(2));
+  // until it gets heavier than 0-2
+  mst.UpdateWeight(id, 20.0);
+  EXPECT_TRUE(mst.InTree(2));
+  EXPECT_DOUBLE_EQ(mst.TotalWeight(), 11.0);
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
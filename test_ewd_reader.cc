@@ -0,0 +1,63 @@
+// @copyright 2019 Shivani Parekh and Urmi Lalchandani
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "ewd_reader.h"
+#include "graph.h"
+
+// Return the edges of EWD text @text, parsed on @threads threads
+static std::vector<Edge> Parse(const std::string &text,
+                               unsigned int threads = 1) {
+  EWDReader reader(text.data(), text.data() + text.size());
+  std::vector<Edge> edges;
+  reader.ParseEdges(edges, threads);
+  return edges;
+}
+
+TEST(EWDReaderTest, ParsesEdges) {
+  std::vector<Edge> edges = Parse("3\n0 1 0.5\n1 2 2\n");
+  ASSERT_EQ(edges.size(), 2u);
+  EXPECT_EQ(edges[1].Source(), 1u);
+  EXPECT_EQ(edges[1].Destination(), 2u);
+  EXPECT_EQ(edges[1].Weight(), 2.0);
+}
+
+TEST(EWDReaderTest, RejectsNonFiniteWeights) {
+  for (const char *weight : {"nan", "NaN", "-nan", "inf", "infinity", "-inf",
+                             "1e999"}) {
+    std::string text = std::string("2\n0 1 0.25\n0 1 ") + weight + "\n";
+    EXPECT_THROW(Parse(text), ParseError) << weight;
+    EXPECT_THROW(Parse(text, 2), ParseError) << weight;
+  }
+}
+
+TEST(EWDReaderTest, RejectsNegativeWeights) {
+  EXPECT_THROW(Parse("2\n0 1 -0.5\n"), ParseError);
+  EXPECT_THROW(Parse("2\n0 1 -1e-300\n"), ParseError);
+}
+
+TEST(EWDReaderTest, NegativeZeroBecomesZero) {
+  std::vector<Edge> edges = Parse("2\n0 1 -0.0\n1 0 -0\n");
+  ASSERT_EQ(edges.size(), 2u);
+  for (const Edge &e : edges) {
+    EXPECT_EQ(e.Weight(), 0.0);
+    EXPECT_FALSE(std::signbit(e.Weight()));
+  }
+}
+
+TEST(EWDReaderTest, ReportsLineOfBadWeight) {
+  try {
+    Parse("3\n0 1 0.5\n1 2 nan\n");
+    FAIL() << "nan accepted";
+  } catch (const ParseError &e) {
+    EXPECT_EQ(e.Line(), 3u);
+    EXPECT_EQ(e.Column(), 5u);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,93 @@
+// @copyright 2019 Shivani Parekh and Urmi Lalchandani
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "graph.h"
+#include "graph_file.h"
+#include "mapped_file.h"
+
+// Path of a scratch graph file for the running test
+static std::string ScratchPath() {
+  return ::testing::TempDir() + "test_graph_file_" +
+         ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+// Writes a small graph to @path and returns the file's bytes
+static std::string WriteSmallGraph(const std::string &path) {
+  Graph graph(4, {Edge(0, 1, 0.5), Edge(1, 2, 2), Edge(2, 3, 1.25),
+                  Edge(3, 0, 3)});
+  WriteGraphFile(graph, path.c_str());
+  std::ifstream in(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+// Replaces the file at @path with @bytes and reads it back as a graph
+static Graph Reread(const std::string &path, const std::string &bytes,
+                    bool verify_checksum = true) {
+  std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+  return ReadGraphFile(std::make_shared<const MappedFile>(path.c_str()),
+                       verify_checksum);
+}
+
+// Byte offset of adjacency weight @i in a file of @v vertices, @e edges
+static size_t WeightAt(size_t v, size_t e, size_t i) {
+  GraphFileSections sections(v, e);
+  return sizeof(GraphFileHeader) + sections.edges + sections.offsets +
+         sections.neighbors + i * sizeof(double);
+}
+
+// Writes @weight over the double at @at in @bytes
+static void Poke(std::string &bytes, size_t at, double weight) {
+  std::memcpy(&bytes[at], &weight, sizeof(weight));
+}
+
+TEST(GraphFileTest, RoundTrips) {
+  const std::string path = ScratchPath();
+  Graph graph = Reread(path, WriteSmallGraph(path));
+  ASSERT_EQ(graph.NumVertices(), 4u);
+  ASSERT_EQ(graph.GetNumEdges(), 4u);
+  EXPECT_EQ(graph.Edges()[2].Weight(), 1.25);
+  std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, RejectsAdjacencyWeightsOffTheirEdge) {
+  const std::string path = ScratchPath();
+  const std::string good = WriteSmallGraph(path);
+  for (double weight : {std::numeric_limits<double>::quiet_NaN(), -5.0,
+                        0.75}) {
+    std::string bad = good;
+    Poke(bad, WeightAt(4, 4, 3), weight);
+    // caught without the checksum too
+    EXPECT_THROW(Reread(path, bad, false), std::runtime_error) << weight;
+    EXPECT_THROW(Reread(path, bad), std::runtime_error) << weight;
+  }
+  std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, ChecksumCatchesConsistentEdits) {
+  // Edge 0-1 reweighed in the edge list (its weight follows the two
+  // vertex numbers) and in both of its adjacency entries, the first of
+  // vertex 0 and of vertex 1, passes every other check
+  const std::string path = ScratchPath();
+  std::string bad = WriteSmallGraph(path);
+  Poke(bad, sizeof(GraphFileHeader) + 2 * sizeof(uint32_t), 0.75);
+  Poke(bad, WeightAt(4, 4, 0), 0.75);
+  Poke(bad, WeightAt(4, 4, 2), 0.75);
+  EXPECT_EQ(Reread(path, bad, false).Edges()[0].Weight(), 0.75);
+  EXPECT_THROW(Reread(path, bad), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,14 +1,63 @@
 // @copyright 2019 Shivani Parekh and Urmi Lalchandani
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "boruvka_mst.h"
+#include "forest_mst.h"
+#include "graph.h"
+#include "index_array_pq.h"
 #include "index_min_pq.h"
+#include "index_pairing_pq.h"
+#include "index_radix_pq.h"
+#include "kruskal_mst.h"
+#include "lazy_prim_mst.h"
+#include "mst.h"
+#include "prim_key.h"
+#include "simd_argmin.h"
+
+// Queues every test runs against: the heap layouts (arity and whether keys
+// are stored inline in the heap array), the pairing heap and radix heap
+template <unsigned int D, bool InlineKeys>
+struct Layout {
+  template <typename K>
+  using Of = IndexMinPQ<K, D, InlineKeys>;
+};
+struct Pairing {
+  template <typename K>
+  using Of = IndexPairingPQ<K>;
+};
+struct Radix {
+  template <typename K>
+  using Of = IndexRadixPQ<K>;
+};
+template <typename L, typename K>
+using PQ = typename L::template Of<K>;
+
+typedef ::testing::Types<Layout<2, false>, Layout<4, false>, Layout<8, false>,
+                         Layout<2, true>, Layout<4, true>, Layout<8, true>,
+                         Pairing, Radix>
+    Layouts;
+
+template <typename L>
+class IndexMinPQTest : public ::testing::Test {};
+TYPED_TEST_SUITE(IndexMinPQTest, Layouts);
+
+template <typename L>
+class IntMinPQTest : public ::testing::Test {};
+TYPED_TEST_SUITE(IntMinPQTest, Layouts);
 
 
 /* Test cases for doubles */
 
-TEST(IndexMinPQ, SimpleScenario) {
+TYPED_TEST(IndexMinPQTest, SimpleScenario) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<double> impq(100);
+  PQ<TypeParam, double> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<double, unsigned int>> keyval{
@@ -37,9 +86,9 @@ TEST(IndexMinPQ, SimpleScenario) {
   EXPECT_EQ(impq.Top(), 93);
 }
 
-TEST(IndexMinPQ, Overflow) {
+TYPED_TEST(IndexMinPQTest, Overflow) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<double> impq(100);
+  PQ<TypeParam, double> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<double, unsigned int>> keyval{
@@ -55,9 +104,9 @@ TEST(IndexMinPQ, Overflow) {
   EXPECT_THROW(impq.Push(7.7, 102), std::overflow_error);
 }
 
-TEST(IndexMinPQ, RepeatValue) {
+TYPED_TEST(IndexMinPQTest, RepeatValue) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<double> impq(100);
+  PQ<TypeParam, double> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<double, unsigned int>> keyval{
@@ -73,9 +122,9 @@ TEST(IndexMinPQ, RepeatValue) {
   EXPECT_THROW(impq.Push(7.7, 99), std::runtime_error);
 }
 
-TEST(IndexMinPQ, RepeatKey) {
+TYPED_TEST(IndexMinPQTest, RepeatKey) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<double> impq(100);
+  PQ<TypeParam, double> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<double, unsigned int>> keyval{
@@ -93,9 +142,9 @@ TEST(IndexMinPQ, RepeatKey) {
   EXPECT_EQ(impq.Top(), 99);
 }
 
-TEST(IndexMinPQ, Underflow) {
+TYPED_TEST(IndexMinPQTest, Underflow) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<double> impq(100);
+  PQ<TypeParam, double> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<double, unsigned int>> keyval{
@@ -113,9 +162,9 @@ TEST(IndexMinPQ, Underflow) {
   EXPECT_THROW(impq.Pop(), std::underflow_error);
 }
 
-TEST(IndexMinPQ, SimpleChangeKey) {
+TYPED_TEST(IndexMinPQTest, SimpleChangeKey) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<double> impq(100);
+  PQ<TypeParam, double> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<double, unsigned int>> keyval{
@@ -138,9 +187,9 @@ TEST(IndexMinPQ, SimpleChangeKey) {
   EXPECT_EQ(impq.Top(), 32);
 }
 
-TEST(IndexMinPQ, ChangeKeyIdxOutofBounds) {
+TYPED_TEST(IndexMinPQTest, ChangeKeyIdxOutofBounds) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<double> impq(100);
+  PQ<TypeParam, double> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<double, unsigned int>> keyval{
@@ -154,9 +203,9 @@ TEST(IndexMinPQ, ChangeKeyIdxOutofBounds) {
   EXPECT_THROW(impq.ChangeKey(2.2, 102), std::overflow_error);
 }
 
-TEST(IndexMinPQ, ChangeKeyNonexistent) {
+TYPED_TEST(IndexMinPQTest, ChangeKeyNonexistent) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<double> impq(100);
+  PQ<TypeParam, double> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<double, unsigned int>> keyval{
@@ -170,9 +219,9 @@ TEST(IndexMinPQ, ChangeKeyNonexistent) {
   EXPECT_THROW(impq.ChangeKey(1.0, 52), std::runtime_error);
 }
 
-TEST(IndexMinPQ, SimplePop) {
+TYPED_TEST(IndexMinPQTest, SimplePop) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<double> impq(100);
+  PQ<TypeParam, double> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<double, unsigned int>> keyval{
@@ -197,9 +246,9 @@ TEST(IndexMinPQ, SimplePop) {
   EXPECT_FALSE(impq.Contains(32));
 }
 
-TEST(IndexMinPQ, SimplePush) {
+TYPED_TEST(IndexMinPQTest, SimplePush) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<double> impq(100);
+  PQ<TypeParam, double> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<double, unsigned int>> keyval{
@@ -223,9 +272,9 @@ TEST(IndexMinPQ, SimplePush) {
 
 /*Test cases for ints*/
 
-TEST(IntMinPQ, SimpleScenario) {
+TYPED_TEST(IntMinPQTest, SimpleScenario) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<unsigned int> impq(100);
+  PQ<TypeParam, unsigned int> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<unsigned int, unsigned int>> keyval{
@@ -254,9 +303,9 @@ TEST(IntMinPQ, SimpleScenario) {
   EXPECT_EQ(impq.Top(), 93);
 }
 
-TEST(IntMinPQ, Overflow) {
+TYPED_TEST(IntMinPQTest, Overflow) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<unsigned int> impq(100);
+  PQ<TypeParam, unsigned int> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<unsigned int, unsigned int>> keyval{
@@ -272,9 +321,9 @@ TEST(IntMinPQ, Overflow) {
   EXPECT_THROW(impq.Push(7, 102), std::overflow_error);
 }
 
-TEST(IntMinPQ, RepeatValue) {
+TYPED_TEST(IntMinPQTest, RepeatValue) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<unsigned int> impq(100);
+  PQ<TypeParam, unsigned int> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<unsigned int, unsigned int>> keyval{
@@ -290,9 +339,9 @@ TEST(IntMinPQ, RepeatValue) {
   EXPECT_THROW(impq.Push(7, 99), std::runtime_error);
 }
 
-TEST(IntMinPQ, RepeatKey) {
+TYPED_TEST(IntMinPQTest, RepeatKey) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<unsigned int> impq(100);
+  PQ<TypeParam, unsigned int> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<unsigned int, unsigned int>> keyval{
@@ -311,9 +360,9 @@ TEST(IntMinPQ, RepeatKey) {
   EXPECT_EQ(impq.Top(), 99);
 }
 
-TEST(IntMinPQ, Underflow) {
+TYPED_TEST(IntMinPQTest, Underflow) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<unsigned int> impq(100);
+  PQ<TypeParam, unsigned int> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<unsigned int, unsigned int>> keyval{
@@ -331,9 +380,9 @@ TEST(IntMinPQ, Underflow) {
   EXPECT_THROW(impq.Pop(), std::underflow_error);
 }
 
-TEST(IntMinPQ, SimpleChangeKey) {
+TYPED_TEST(IntMinPQTest, SimpleChangeKey) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<unsigned int> impq(100);
+  PQ<TypeParam, unsigned int> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<unsigned int, unsigned int>> keyval{
@@ -356,9 +405,9 @@ TEST(IntMinPQ, SimpleChangeKey) {
   EXPECT_EQ(impq.Top(), 32);
 }
 
-TEST(IntMinPQ, ChangeKeyIdxOutofBounds) {
+TYPED_TEST(IntMinPQTest, ChangeKeyIdxOutofBounds) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<unsigned int> impq(100);
+  PQ<TypeParam, unsigned int> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<unsigned int, unsigned int>> keyval{
@@ -372,9 +421,9 @@ TEST(IntMinPQ, ChangeKeyIdxOutofBounds) {
   EXPECT_THROW(impq.ChangeKey(2, 102), std::overflow_error);
 }
 
-TEST(IntMinPQ, ChangeKeyNonexistent) {
+TYPED_TEST(IntMinPQTest, ChangeKeyNonexistent) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<unsigned int> impq(100);
+  PQ<TypeParam, unsigned int> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<unsigned int, unsigned int>> keyval{
@@ -388,9 +437,9 @@ TEST(IntMinPQ, ChangeKeyNonexistent) {
   EXPECT_THROW(impq.ChangeKey(1, 52), std::runtime_error);
 }
 
-TEST(IntMinPQ, SimplePop) {
+TYPED_TEST(IntMinPQTest, SimplePop) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<unsigned int> impq(100);
+  PQ<TypeParam, unsigned int> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<unsigned int, unsigned int>> keyval{
@@ -415,9 +464,9 @@ TEST(IntMinPQ, SimplePop) {
   EXPECT_FALSE(impq.Contains(32));
 }
 
-TEST(IntMinPQ, SimplePush) {
+TYPED_TEST(IntMinPQTest, SimplePush) {
   // Indexed min-priority queue of capacity 100
-  IndexMinPQ<unsigned int> impq(100);
+  PQ<TypeParam, unsigned int> impq(100);
 
   // Insert a bunch of key-value
   std::vector<std::pair<unsigned int, unsigned int>> keyval{
@@ -436,6 +485,467 @@ TEST(IntMinPQ, SimplePush) {
   EXPECT_TRUE(impq.Contains(24));
 }
 
+/* Test cases deep enough to exercise every level of the wider heaps */
+
+TYPED_TEST(IndexMinPQTest, RandomChangeKeyPopsInOrder) {
+  // Indexed min-priority queue of capacity 1000
+  PQ<TypeParam, double> impq(1000);
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> key(0.0, 100.0);
+
+  std::vector<double> keys(1000);
+  for (unsigned int i = 0; i < keys.size(); i++) {
+    keys[i] = key(gen);
+    impq.Push(keys[i], i);
+  }
+  // Move every third key up or down
+  for (unsigned int i = 0; i < keys.size(); i += 3) {
+    keys[i] = key(gen);
+    impq.ChangeKey(keys[i], i);
+  }
+
+  // Indexes must come out by nondecreasing key, each exactly once
+  double last = -1;
+  std::vector<bool> popped(keys.size(), false);
+  while (impq.Size()) {
+    unsigned int top = impq.Top();
+    EXPECT_LE(last, keys[top]);
+    EXPECT_FALSE(popped[top]);
+    last = keys[top];
+    popped[top] = true;
+    impq.Pop();
+    EXPECT_FALSE(impq.Contains(top));
+  }
+  EXPECT_EQ(std::count(popped.begin(), popped.end(), true), 1000);
+}
+
+TYPED_TEST(IndexMinPQTest, InterleavedOperationsMatchSortedOrder) {
+  // Random mix of pushes, pops and key changes in both directions; keys
+  // also go below the last popped minimum, as they do in Prim's
+  PQ<TypeParam, double> impq(500);
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> key(0.0, 10.0);
+  std::uniform_int_distribution<unsigned int> index(0, 499);
+  std::vector<double> keys(500, -1);  // -1 when not in the queue
+
+  for (int step = 0; step < 20000; step++) {
+    unsigned int idx = index(gen);
+    if (step % 3 == 0 && impq.Size()) {
+      // Top must hold the smallest key in the queue
+      unsigned int top = impq.Top();
+      for (double k : keys)
+        EXPECT_TRUE(k < 0 || keys[top] <= k);
+      keys[top] = -1;
+      impq.Pop();
+    } else if (keys[idx] < 0) {
+      keys[idx] = key(gen);
+      impq.Push(keys[idx], idx);
+    } else {
+      keys[idx] = key(gen);
+      impq.ChangeKey(keys[idx], idx);
+    }
+  }
+}
+
+/* Batched operations, on the heap layouts only */
+
+typedef ::testing::Types<Layout<2, false>, Layout<4, false>, Layout<8, false>,
+                         Layout<2, true>, Layout<4, true>, Layout<8, true>>
+    HeapLayouts;
+
+template <typename L>
+class BatchMinPQTest : public ::testing::Test {};
+TYPED_TEST_SUITE(BatchMinPQTest, HeapLayouts);
+
+// Pops every index of @impq, checking that keys come out nondecreasing
+// against @keys, return the number popped
+template <typename Q>
+static size_t PopAllInOrder(Q &impq, const std::vector<double> &keys) {
+  size_t popped = 0;
+  double last = -1;
+  while (impq.Size()) {
+    unsigned int top = impq.Top();
+    EXPECT_LE(last, keys[top]);
+    last = keys[top];
+    impq.Pop();
+    EXPECT_FALSE(impq.Contains(top));
+    popped++;
+  }
+  return popped;
+}
+
+TYPED_TEST(BatchMinPQTest, SimpleScenario) {
+  // Same scenario as SimpleScenario, the keys pushed as one batch
+  PQ<TypeParam, double> impq(10);
+  impq.PushBatch({{0.4, 4}, {0.8, 0}, {0.2, 9}, {0.1, 3}});
+  EXPECT_EQ(impq.Size(), 4u);
+  EXPECT_TRUE(impq.Contains(9));
+  EXPECT_FALSE(impq.Contains(1));
+  EXPECT_EQ(impq.Top(), 3u);
+  impq.Pop();
+  EXPECT_EQ(impq.Top(), 9u);
+  impq.Pop();
+  EXPECT_EQ(impq.Top(), 4u);
+  impq.Pop();
+  EXPECT_EQ(impq.Top(), 0u);
+  impq.Pop();
+  EXPECT_EQ(impq.Size(), 0u);
+
+  // An empty batch changes nothing
+  impq.PushBatch({});
+  EXPECT_EQ(impq.Size(), 0u);
+}
+
+TYPED_TEST(BatchMinPQTest, PushBatchBuildsHeap) {
+  // One batch into an empty queue: heapified bottom-up
+  PQ<TypeParam, double> impq(3000);
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> key(0.0, 100.0);
+  std::vector<double> keys(3000);
+  std::vector<std::pair<double, unsigned int>> items;
+  for (unsigned int i = 0; i < 2000; i++) {
+    keys[i] = key(gen);
+    items.emplace_back(keys[i], i);
+  }
+  impq.PushBatch(items);
+  EXPECT_EQ(impq.Size(), 2000u);
+
+  // Then a small batch into the full heap, percolated one by one, and a
+  // big one after a few pops
+  items.clear();
+  for (unsigned int i = 2000; i < 2010; i++) {
+    keys[i] = key(gen);
+    items.emplace_back(keys[i], i);
+  }
+  impq.PushBatch(items);
+  for (int i = 0; i < 5; i++)
+    impq.Pop();
+  items.clear();
+  for (unsigned int i = 2010; i < 3000; i++) {
+    keys[i] = key(gen);
+    items.emplace_back(keys[i], i);
+  }
+  impq.PushBatch(items);
+  EXPECT_EQ(PopAllInOrder(impq, keys), 2995u);
+}
+
+TYPED_TEST(BatchMinPQTest, PushBatchBadIndexChangesNothing) {
+  PQ<TypeParam, double> impq(10);
+  impq.Push(0.5, 2);
+  // Out of range, already in the queue, and repeated within the batch
+  EXPECT_THROW(impq.PushBatch({{0.1, 1}, {0.2, 10}}), std::overflow_error);
+  EXPECT_THROW(impq.PushBatch({{0.1, 1}, {0.2, 2}}), std::runtime_error);
+  EXPECT_THROW(impq.PushBatch({{0.1, 1}, {0.2, 3}, {0.3, 1}}),
+               std::runtime_error);
+  EXPECT_EQ(impq.Size(), 1u);
+  EXPECT_FALSE(impq.Contains(1));
+  EXPECT_FALSE(impq.Contains(3));
+  EXPECT_EQ(impq.Top(), 2u);
+
+  // The queue still works
+  impq.PushBatch({{0.1, 1}, {0.9, 3}});
+  EXPECT_EQ(impq.Top(), 1u);
+}
+
+TYPED_TEST(BatchMinPQTest, ChangeKeyBatchPopsInOrder) {
+  PQ<TypeParam, double> impq(1000);
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> key(0.0, 100.0);
+  std::vector<double> keys(1000);
+  for (unsigned int i = 0; i < keys.size(); i++) {
+    keys[i] = key(gen);
+    impq.Push(keys[i], i);
+  }
+
+  // A few changes, repaired one by one, then most keys, repaired at once;
+  // keys go both up and down, and an index may repeat (last one wins)
+  for (unsigned int count : {3u, 800u}) {
+    std::vector<std::pair<double, unsigned int>> items;
+    for (unsigned int k = 0; k < count; k++) {
+      unsigned int idx = (k * 7) % keys.size();
+      keys[idx] = key(gen);
+      items.emplace_back(keys[idx], idx);
+    }
+    impq.ChangeKeyBatch(items);
+  }
+  EXPECT_EQ(PopAllInOrder(impq, keys), 1000u);
+}
+
+TYPED_TEST(BatchMinPQTest, ChangeKeyBatchBadIndexChangesNothing) {
+  PQ<TypeParam, double> impq(10);
+  impq.PushBatch({{0.5, 2}, {0.7, 4}});
+  EXPECT_THROW(impq.ChangeKeyBatch({{0.1, 4}, {0.2, 10}}),
+               std::overflow_error);
+  EXPECT_THROW(impq.ChangeKeyBatch({{0.1, 4}, {0.2, 5}}),
+               std::runtime_error);
+  EXPECT_EQ(impq.Top(), 2u);
+  impq.ChangeKeyBatch({{0.1, 4}});
+  EXPECT_EQ(impq.Top(), 4u);
+}
+
+TEST(CountedMinPQTest, BuildIsLinear) {
+  // Bottom-up heapify of n keys in decreasing order moves each node at
+  // most its height: fewer than n moves in all, where pushing them one by
+  // one moves every node up to the root
+  const unsigned int n = 1 << 14;
+  std::vector<std::pair<double, unsigned int>> items;
+  for (unsigned int i = 0; i < n; i++)
+    items.emplace_back(n - i, i);
+  IndexMinPQ<double, 2, false, true> batch(n), single(n);
+  batch.PushBatch(items);
+  for (const auto &item : items)
+    single.Push(item.first, item.second);
+  EXPECT_EQ(batch.Counters().push, n);
+  EXPECT_LT(batch.Counters().percolate_steps, n);
+  EXPECT_GT(single.Counters().percolate_steps, 10u * n);
+  EXPECT_EQ(batch.Top(), n - 1);
+}
+
+/* Counting heap */
+
+TEST(CountedMinPQTest, CountsOperationsAndSteps) {
+  IndexMinPQ<double, 2, false, true> impq(8);
+  EXPECT_TRUE((IsCountedPQ<IndexMinPQ<double, 2, false, true>>::value));
+  EXPECT_FALSE((IsCountedPQ<IndexMinPQ<double, 2>>::value));
+
+  // Decreasing keys: every push percolates to the root
+  for (unsigned int i = 0; i < 4; i++)
+    impq.Push(10.0 - i, i);
+  EXPECT_EQ(impq.Counters().push, 4u);
+  EXPECT_EQ(impq.Counters().percolate_steps, 0u + 1 + 1 + 2);
+
+  impq.ChangeKey(0.5, 0);
+  EXPECT_EQ(impq.Top(), 0u);
+  EXPECT_EQ(impq.Counters().change_key, 1u);
+  while (impq.Size())
+    impq.Pop();
+  EXPECT_EQ(impq.Counters().pop, 4u);
+  EXPECT_EQ(impq.Counters().arcs_scanned, 0u);
+}
+
+/* Array scan */
+
+TEST(IndexArrayPQTest, PopsInOrderLowestIndexFirst) {
+  // equal keys come out lowest index first, as ArgMin finds them
+  IndexArrayPQ<double, true> impq(6);
+  impq.Push(3.0, 5);
+  impq.Push(1.0, 4);
+  impq.Push(2.0, 0);
+  impq.Push(1.0, 2);
+  EXPECT_THROW(impq.Push(9.0, 2), std::runtime_error);
+  EXPECT_THROW(impq.ChangeKey(9.0, 1), std::runtime_error);
+  EXPECT_THROW(impq.Contains(6), std::overflow_error);
+  impq.ChangeKey(0.5, 5);
+
+  std::vector<unsigned int> order;
+  while (impq.Size()) {
+    order.push_back(impq.Top());
+    impq.Pop();
+  }
+  EXPECT_EQ(order, (std::vector<unsigned int>{5, 2, 4, 0}));
+  EXPECT_THROW(impq.Top(), std::underflow_error);
+  EXPECT_EQ(impq.Counters().push, 4u);
+  EXPECT_EQ(impq.Counters().change_key, 1u);
+  EXPECT_EQ(impq.Counters().pop, 4u);
+}
+
+TEST(IndexArrayPQTest, EqualWeightsByTieBreak) {
+  // the first lightest found by ArgMin is not the one of least edge id
+  IndexArrayPQ<PrimKey> impq(40);
+  impq.Push(PrimKey{2.0, 1}, 3);
+  impq.Push(PrimKey{1.0, 9}, 5);
+  impq.Push(PrimKey{1.0, 4}, 37);
+  impq.Push(PrimKey{1.0, 7}, 20);
+  std::vector<unsigned int> order;
+  while (impq.Size()) {
+    order.push_back(impq.Top());
+    impq.Pop();
+  }
+  EXPECT_EQ(order, (std::vector<unsigned int>{37, 20, 5, 3}));
+}
+
+TEST(ArgMinTest, VersionsAgreeOnPositionAndTies) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> value(0, 20);
+  for (size_t n = 1; n < 100; n++) {
+    std::vector<double> values(n);
+    for (double &v : values)
+      v = value(gen);
+    const size_t expected =
+        std::min_element(values.begin(), values.end()) - values.begin();
+    const bool expected_tied =
+        std::count(values.begin(), values.end(), values[expected]) > 1;
+    bool tied;
+    EXPECT_EQ(ArgMinScalar(values.data(), n, &tied), expected);
+    EXPECT_EQ(tied, expected_tied);
+    EXPECT_EQ(ArgMin(values.data(), n, &tied), expected);
+    EXPECT_EQ(tied, expected_tied);
+#if defined(__x86_64__)
+    EXPECT_EQ(ArgMinSSE2(values.data(), n, &tied), expected);
+    EXPECT_EQ(tied, expected_tied);
+    if (__builtin_cpu_supports("avx2")) {
+      EXPECT_EQ(ArgMinAVX2(values.data(), n, &tied), expected);
+      EXPECT_EQ(tied, expected_tied);
+    }
+#endif
+  }
+}
+
+TEST(PrimModeTest, AutoScansOnlyNearlyCompleteGraphs) {
+  // the array scan never percolates; a heap does whenever a key drops
+  typedef MST<IndexMinPQ<PrimKey, 2, false, true>> CountedMST;
+  const unsigned int n = 64;
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> weight(0.0, 1.0);
+  std::vector<Edge> complete, half;
+  for (unsigned int u = 0; u < n; u++) {
+    for (unsigned int v = u + 1; v < n; v++) {
+      complete.push_back(Edge(u, v, weight(gen)));
+      if ((u + v) % 2)
+        half.push_back(complete.back());
+    }
+  }
+  Graph dense(n, complete), sparser(n, half);
+  CountedMST automatic(dense), scanned(dense, PrimMode::kDense);
+  EXPECT_EQ(automatic.Counters().percolate_steps, 0u);
+  EXPECT_EQ(automatic.Result().TotalWeight(),
+            scanned.Result().TotalWeight());
+  EXPECT_GT(CountedMST(sparser).Counters().percolate_steps, 0u);
+  EXPECT_GT(CountedMST(dense, PrimMode::kHeap).Counters().percolate_steps,
+            0u);
+}
+
+/* Radix heap */
+
+TEST(IndexRadixPQTest, NegativeZeroIsZero) {
+  // -0.0 has the sign bit set; unmapped, it would sort after every key
+  IndexRadixPQ<double> impq(4);
+  impq.Push(0.5, 0);
+  impq.Push(-0.0, 1);
+  impq.Push(1.0, 2);
+  EXPECT_EQ(impq.Top(), 1u);
+  impq.Pop();
+  impq.ChangeKey(-0.0, 2);
+  EXPECT_EQ(impq.Top(), 2u);
+}
+
+TEST(IndexRadixPQTest, PrimIsNLogN) {
+  // Prim's pushes most keys below the last minimum, into bucket 0: on a
+  // sparse random graph of 2^17 vertices the heap and bucket moves must
+  // stay within O(log V) per queue operation, as for the binary heap
+  const unsigned int n = 1 << 17;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<unsigned int> vertex(0, n - 1);
+  std::uniform_real_distribution<double> weight(0.0, 1.0);
+  std::vector<Edge> edges;
+  for (unsigned int v = 1; v < n; v++)
+    edges.push_back(Edge(v - 1, v, weight(gen)));
+  while (edges.size() < 8u * n)
+    edges.push_back(Edge(vertex(gen), vertex(gen), weight(gen)));
+  Graph graph(n, std::move(edges));
+
+  MST<IndexRadixPQ<PrimKey, true>> radix(graph, PrimMode::kHeap);
+  MST<IndexMinPQ<PrimKey, 2, false, true>> binary(graph, PrimMode::kHeap);
+  EXPECT_DOUBLE_EQ(radix.Result().TotalWeight(),
+                   binary.Result().TotalWeight());
+  const MSTCounters &counters = radix.Counters();
+  EXPECT_EQ(counters.pop, n);
+  const uint64_t operations =
+      counters.push + counters.change_key + counters.pop;
+  EXPECT_LT(counters.percolate_steps, operations * std::log2(n));
+  EXPECT_LT(counters.percolate_steps,
+            2 * binary.Counters().percolate_steps);
+}
+
+/* Tie order */
+
+// Expects @forest to hold the edges of @expected, vertex by vertex
+static void ExpectSameForest(const MSTResult &forest,
+                             const MSTResult &expected) {
+  ASSERT_EQ(forest.NumVertices(), expected.NumVertices());
+  for (unsigned int v = 0; v < forest.NumVertices(); v++) {
+    const Edge &e = forest.Edges()[v], &f = expected.Edges()[v];
+    EXPECT_EQ(e.Source(), f.Source()) << "vertex " << v;
+    EXPECT_EQ(e.Destination(), f.Destination()) << "vertex " << v;
+    EXPECT_EQ(e.Weight(), f.Weight()) << "vertex " << v;
+  }
+}
+
+TEST(PrimTieTest, EveryQueueFindsBoruvkasForest) {
+  // three weights only: almost every choice Prim's makes is among ties,
+  // which every queue must break by edge id as Borůvka's and Kruskal's do
+  const unsigned int n = 500;
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<unsigned int> vertex(0, n - 1);
+  std::uniform_int_distribution<int> weight(1, 3);
+  std::vector<Edge> edges;
+  while (edges.size() < 6u * n)
+    edges.push_back(Edge(vertex(gen), vertex(gen), weight(gen)));
+  DedupEdges(edges);
+  Graph graph(n, std::move(edges));
+
+  MSTResult expected = BoruvkaMST(graph, 4).Result();
+  ExpectSameForest(MST<>(graph).Result(), expected);
+  ExpectSameForest(MST<IndexMinPQ<PrimKey, 4, true>>(graph).Result(),
+                   expected);
+  ExpectSameForest(MST<IndexPairingPQ<PrimKey>>(graph).Result(), expected);
+  ExpectSameForest(MST<IndexRadixPQ<PrimKey>>(graph).Result(), expected);
+  ExpectSameForest(MST<>(graph, PrimMode::kDense).Result(), expected);
+  ExpectSameForest(ForestMST<>(graph, 4).Result(), expected);
+  ExpectSameForest(KruskalMST(graph, 4).Result(), expected);
+  ExpectSameForest(LazyPrimMST(graph).Result(), expected);
+}
+
+/* Lazy deletion */
+
+TEST(PackedLazyPQTest, PopsAsExactKeysBelowTheIndexBits) {
+  // 1000 indexes take the last 10 mantissa bits of the words, so these
+  // weights all pack alike and only the exact keys tell them apart
+  const double eps = std::numeric_limits<double>::epsilon();
+  const unsigned int n = 1000;
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<unsigned int> index(0, n - 1);
+  std::uniform_int_distribution<int> steps(0, 7), edge(0, 3);
+  PackedLazyPQ lazy(n);
+  IndexMinPQ<PrimKey> exact(n);
+  std::vector<PrimKey> keys(n, PrimKey::Infinity());
+  for (int round = 0; round < 20000; round++) {
+    unsigned int i = index(gen);
+    // as in Prim's, no two indexes share a key: the edges differ
+    PrimKey key{1 + steps(gen) * eps, 4 * i + edge(gen)};
+    if (round % 3 == 2 && exact.Size()) {
+      ASSERT_EQ(lazy.Top(), exact.Top());
+      keys[exact.Top()] = PrimKey::Infinity();
+      lazy.Pop();
+      exact.Pop();
+    } else if (!exact.Contains(i)) {
+      keys[i] = key;
+      lazy.Push(key, i);
+      exact.Push(key, i);
+    } else if (key < keys[i]) {
+      keys[i] = key;
+      lazy.ChangeKey(key, i);
+      exact.ChangeKey(key, i);
+    }
+    ASSERT_EQ(lazy.Size(), exact.Size());
+  }
+  while (exact.Size()) {
+    ASSERT_EQ(lazy.Top(), exact.Top());
+    lazy.Pop();
+    exact.Pop();
+  }
+}
+
+TEST(PackedLazyPQTest, LazyPrimIsMinimum) {
+  // 0-1 and 1-2 differ from 0-2 only in bits the vertex takes: truncated
+  // alike, 0-1 would join before 1-2 could improve on it
+  const double eps = std::numeric_limits<double>::epsilon();
+  Graph graph(3, {Edge(0, 1, 1 + 2 * eps), Edge(0, 2, 1),
+                  Edge(1, 2, 1 + eps)});
+  EXPECT_EQ(LazyPrimMST(graph).Result().TotalWeight(), 2 + eps);
+  ExpectSameForest(LazyPrimMST(graph).Result(), MST<>(graph).Result());
+}
+
 
 int main(int argc, char *argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,91 @@
+// @copyright 2019 Urmi Lalchandani and Shivani Parekh
+
+#ifndef UNION_FIND_H_
+#define UNION_FIND_H_
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// CONCURRENT UNION FIND CLASS
+// Disjoint sets over [0, n) that several threads may Find and Union on at
+// once. Roots are linked by compare-and-swap, always the larger root
+// under the smaller one, so there are no cycles; Find halves paths with
+// benign racing writes.
+class ConcurrentUnionFind {
+ public:
+  explicit ConcurrentUnionFind(size_t n) : parent(n) {
+    for (size_t i = 0; i < n; i++)
+      parent[i].store(i, std::memory_order_relaxed);
+  }
+  // return the root of the set holding @x
+  unsigned int Find(unsigned int x) {
+    unsigned int p = parent[x].load(std::memory_order_relaxed);
+    while (p != x) {
+      unsigned int gp = parent[p].load(std::memory_order_relaxed);
+      // path halving: point x at its grandparent; losing the race is fine
+      parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+      x = p;
+      p = parent[x].load(std::memory_order_relaxed);
+    }
+    return x;
+  }
+  // merges the sets holding @a and @b, return false if already merged
+  bool Union(unsigned int a, unsigned int b) {
+    while (true) {
+      a = Find(a);
+      b = Find(b);
+      if (a == b)
+        return false;
+      if (a > b)
+        std::swap(a, b);
+      // b is still a root only if nobody linked it meanwhile
+      unsigned int expected = b;
+      if (parent[b].compare_exchange_strong(expected, a,
+                                            std::memory_order_acq_rel))
+        return true;
+    }
+  }
+
+ private:
+  std::vector<std::atomic<unsigned int>> parent;
+};
+
+// UNION FIND CLASS
+// Single-threaded disjoint sets over [0, n) with union by rank and path
+// halving
+class UnionFind {
+ public:
+  explicit UnionFind(size_t n) : parent(n), rank(n, 0) {
+    for (size_t i = 0; i < n; i++)
+      parent[i] = i;
+  }
+  // return the root of the set holding @x
+  unsigned int Find(unsigned int x) {
+    while (parent[x] != x) {
+      parent[x] = parent[parent[x]];
+      x = parent[x];
+    }
+    return x;
+  }
+  // merges the sets holding @a and @b, return false if already merged
+  bool Union(unsigned int a, unsigned int b) {
+    a = Find(a);
+    b = Find(b);
+    if (a == b)
+      return false;
+    if (rank[a] < rank[b])
+      std::swap(a, b);
+    parent[b] = a;
+    if (rank[a] == rank[b])
+      rank[a]++;
+    return true;
+  }
+
+ private:
+  std::vector<unsigned int> parent;
+  std::vector<unsigned char> rank;
+};
+
+#endif  // UNION_FIND_H_